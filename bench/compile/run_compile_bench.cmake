@@ -0,0 +1,187 @@
+#
+# Generates synthetic translation units that stress the templates in the
+# composer headers, compiles each of them and writes one CSV line per
+# scenario and size to ${RESULT}.
+#
+# Expected variables: COMPILER, COMPILER_ID, FLAGS, INCLUDE_DIR,
+# TEMPLATE_DIR, WORK_DIR, REPETITIONS, RESULT
+#
+
+cmake_minimum_required(VERSION 3.31)
+
+set(pipe_sizes 4 16 64)
+set(bind_sizes 4 16 32)
+set(op_sizes 4 16 64)
+set(algorithm_sizes 1 4 8)
+
+function(generate_pipe n out)
+    set(ops plus minus multiplies bit_xor)
+    set(src "#include <composer/functional.hpp>\n\n")
+    string(APPEND src "int run(int x)\n{\n    constexpr auto f = composer::identity")
+    math(EXPR last "${n} - 1")
+    foreach (i RANGE ${last})
+        math(EXPR op_index "${i} % 4")
+        list(GET ops ${op_index} op)
+        string(APPEND src "\n        | composer::${op}(${i})")
+    endforeach ()
+    string(APPEND src ";\n    return f(x);\n}\n")
+    set(${out} "${src}" PARENT_SCOPE)
+endfunction()
+
+function(generate_bind kind n out)
+    set(src "#include <composer/${kind}.hpp>\n\n")
+    string(APPEND src "inline constexpr auto sum\n")
+    string(APPEND src "    = composer::make_composable_function<composer::${kind}>(\n")
+    string(APPEND src "        []<typename... Ts>(Ts... ts)\n")
+    string(APPEND src "            requires(sizeof...(Ts) == ${n})\n")
+    string(APPEND src "        { return (0 + ... + ts); });\n\n")
+    string(APPEND src "int run(int x)\n{\n    const auto& b0 = sum;\n")
+    math(EXPR last "${n} - 1")
+    if (last GREATER 0)
+        foreach (i RANGE 1 ${last})
+            math(EXPR prev "${i} - 1")
+            string(APPEND src "    auto b${i} = b${prev}(${i});\n")
+        endforeach ()
+    endif ()
+    string(APPEND src "    return b${last}(x);\n}\n")
+    set(${out} "${src}" PARENT_SCOPE)
+endfunction()
+
+function(generate_op n out)
+    set(ops "&&" "||")
+    set(expr "")
+    math(EXPR last "${n} - 1")
+    foreach (i RANGE ${last})
+        math(EXPR m "${i} + 2")
+        set(term "((composer::identity | composer::modulus(${m}))")
+        string(APPEND term " == (composer::identity | composer::bit_and(${i})))")
+        if (i EQUAL 0)
+            set(expr "${term}")
+        else ()
+            math(EXPR op_index "${i} % 2")
+            list(GET ops ${op_index} op)
+            set(expr "(${expr})\n        ${op} ${term}")
+        endif ()
+    endforeach ()
+    set(src "#include <composer/functional.hpp>\n\n")
+    string(APPEND src "bool run(int x)\n{\n    constexpr auto p\n        = ${expr};\n")
+    string(APPEND src "    return p(x);\n}\n")
+    set(${out} "${src}" PARENT_SCOPE)
+endfunction()
+
+function(generate_algorithms n out)
+    file(READ ${TEMPLATE_DIR}/algorithms.hpp.in src)
+    math(EXPR last "${n} - 1")
+    foreach (i RANGE ${last})
+        string(APPEND src "\nstruct record_${i} {\n")
+        string(APPEND src "    int num;\n    std::string_view name;\n};\n\n")
+        string(APPEND src "template void run_all(std::vector<record_${i}>&,\n")
+        string(APPEND src "                      std::vector<record_${i}>&);\n")
+    endforeach ()
+    set(${out} "${src}" PARENT_SCOPE)
+endfunction()
+
+function(now_us out)
+    string(TIMESTAMP value "%s%f" UTC)
+    set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+function(seconds_to_ms seconds out)
+    string(REGEX MATCH "^([0-9]+)\\.?([0-9]*)$" ignored "${seconds}")
+    string(SUBSTRING "${CMAKE_MATCH_2}000" 0 3 fraction)
+    math(EXPR value "${CMAKE_MATCH_1} * 1000 + 1${fraction} - 1000")
+    set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+function(count_matches text pattern out)
+    string(REGEX MATCHALL "${pattern}" matches "${text}")
+    list(LENGTH matches count)
+    set(${out} ${count} PARENT_SCOPE)
+endfunction()
+
+function(measure scenario size src)
+    set(name ${scenario}_${size})
+    set(source ${WORK_DIR}/${name}.cpp)
+    set(object ${WORK_DIR}/${name}.o)
+    file(WRITE ${source} "${src}")
+
+    separate_arguments(flags UNIX_COMMAND "${FLAGS}")
+    list(APPEND flags -I${INCLUDE_DIR})
+    if (COMPILER_ID MATCHES "Clang")
+        list(APPEND flags -ftime-trace -ftime-trace-granularity=0)
+    else ()
+        list(APPEND flags -ftime-report)
+    endif ()
+
+    set(best "")
+    foreach (rep RANGE 1 ${REPETITIONS})
+        now_us(start)
+        execute_process(
+                COMMAND ${COMPILER} ${flags} -c ${source} -o ${object}
+                RESULT_VARIABLE status
+                ERROR_VARIABLE report
+                OUTPUT_QUIET
+        )
+        now_us(stop)
+        if (NOT status EQUAL 0)
+            message(FATAL_ERROR "Failed to compile ${source}:\n${report}")
+        endif ()
+        math(EXPR elapsed "(${stop} - ${start}) / 1000")
+        if (best STREQUAL "" OR elapsed LESS best)
+            set(best ${elapsed})
+        endif ()
+    endforeach ()
+
+    set(template_ms "")
+    set(functions "")
+    set(classes "")
+    if (COMPILER_ID MATCHES "Clang")
+        file(READ ${WORK_DIR}/${name}.json trace)
+        count_matches("${trace}" "\"name\":\"InstantiateFunction\"" functions)
+        count_matches("${trace}" "\"name\":\"InstantiateClass\"" classes)
+        foreach (kind InstantiateFunction InstantiateClass)
+            if (trace MATCHES "\"dur\":([0-9]+),\"name\":\"Total ${kind}\"")
+                if (template_ms STREQUAL "")
+                    set(template_ms 0)
+                endif ()
+                math(EXPR template_ms "${template_ms} + ${CMAKE_MATCH_1} / 1000")
+            endif ()
+        endforeach ()
+    elseif (report MATCHES "template instantiation *: *[0-9.]+ *\\( *[0-9]+%\\) *[0-9.]+ *\\( *[0-9]+%\\) *([0-9.]+)")
+        seconds_to_ms(${CMAKE_MATCH_1} template_ms)
+    endif ()
+
+    message(STATUS
+            "${scenario} ${size}: ${best} ms wall, "
+            "${functions} function / ${classes} class instantiations")
+    file(APPEND ${RESULT}
+         "${COMPILER_ID},${scenario},${size},${best},${template_ms},${functions},${classes}\n")
+endfunction()
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+file(WRITE ${RESULT}
+     "compiler,scenario,size,wall_ms,template_ms,instantiate_function,instantiate_class\n")
+
+foreach (n ${pipe_sizes})
+    generate_pipe(${n} src)
+    measure(pipe ${n} "${src}")
+endforeach ()
+
+foreach (kind front_binding back_binding)
+    foreach (n ${bind_sizes})
+        generate_bind(${kind} ${n} src)
+        measure(${kind} ${n} "${src}")
+    endforeach ()
+endforeach ()
+
+foreach (n ${op_sizes})
+    generate_op(${n} src)
+    measure(op_tree ${n} "${src}")
+endforeach ()
+
+foreach (n ${algorithm_sizes})
+    generate_algorithms(${n} src)
+    measure(algorithms ${n} "${src}")
+endforeach ()
+
+message(STATUS "Results written to ${RESULT}")
@@ -0,0 +1,682 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/transform_args.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct record {
+    std::int32_t num;
+    std::int32_t id;
+    double weight;
+};
+
+enum class distribution { sorted, reversed, random, zipf, few_unique };
+
+constexpr std::array distributions{ distribution::sorted,
+                                    distribution::reversed,
+                                    distribution::random,
+                                    distribution::zipf,
+                                    distribution::few_unique };
+
+constexpr std::string_view name_of(distribution d)
+{
+    switch (d) {
+    case distribution::sorted:
+        return "sorted";
+    case distribution::reversed:
+        return "reversed";
+    case distribution::random:
+        return "random";
+    case distribution::zipf:
+        return "zipf";
+    case distribution::few_unique:
+        return "few_unique";
+    }
+    return "unknown";
+}
+
+struct options {
+    std::size_t min_size = std::size_t{ 1 } << 10;
+    std::size_t max_size = std::size_t{ 1 } << 22;
+    std::chrono::milliseconds min_time{ 50 };
+    int repetitions = 5;
+    std::string output = "composer_bench.json";
+    std::string baseline;
+    double tolerance = 0.10;
+    double max_overhead = -1.0;
+    bool report_only = false;
+    std::string filter;
+};
+
+struct result {
+    std::string algorithm;
+    std::string variant;
+    std::string distribution;
+    std::size_t size;
+    double ns_per_element;
+};
+
+volatile std::size_t sink;
+
+std::vector<std::int32_t> zipf_keys(std::size_t n, std::mt19937_64& rng)
+{
+    std::vector<double> cumulative(n);
+    double sum = 0.0;
+    for (std::size_t i = 0; i != n; ++i) {
+        sum += 1.0 / static_cast<double>(i + 1);
+        cumulative[i] = sum;
+    }
+    std::uniform_real_distribution<double> uniform(0.0, sum);
+    std::vector<std::int32_t> keys(n);
+    for (auto& key : keys) {
+        auto rank = std::ranges::lower_bound(cumulative, uniform(rng));
+        key = static_cast<std::int32_t>(rank - cumulative.begin());
+    }
+    return keys;
+}
+
+std::vector<record>
+make_data(distribution d, std::size_t n, std::mt19937_64& rng)
+{
+    const auto top = static_cast<std::int32_t>(n);
+    std::vector<std::int32_t> keys(n);
+    switch (d) {
+    case distribution::sorted:
+        std::ranges::iota(keys, 0);
+        break;
+    case distribution::reversed:
+        std::ranges::generate(keys, [k = top]() mutable { return --k; });
+        break;
+    case distribution::random: {
+        std::uniform_int_distribution<std::int32_t> uniform(0, top - 1);
+        std::ranges::generate(keys, [&] { return uniform(rng); });
+        break;
+    }
+    case distribution::zipf:
+        keys = zipf_keys(n, rng);
+        break;
+    case distribution::few_unique: {
+        std::uniform_int_distribution<std::int32_t> uniform(0, 15);
+        std::ranges::generate(keys, [&] { return uniform(rng); });
+        break;
+    }
+    }
+    std::vector<record> data(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        data[i] = { keys[i],
+                    static_cast<std::int32_t>(i),
+                    1.0 / (1.0 + static_cast<double>(i)) };
+    }
+    return data;
+}
+
+struct no_setup {
+    void operator()() const {}
+};
+
+// The time of iterations calls of run. A setup other than no_setup is called
+// before each of them, to e.g. restore the input that run modifies, and is
+// not timed.
+template <typename Setup, typename F>
+std::chrono::duration<double, std::nano>
+time_runs(std::size_t iterations, Setup& setup, F& run)
+{
+    using clock = std::chrono::steady_clock;
+    if constexpr (std::same_as<Setup, no_setup>) {
+        const auto start = clock::now();
+        for (std::size_t i = 0; i != iterations; ++i) {
+            sink = sink + run();
+        }
+        return clock::now() - start;
+    } else {
+        std::chrono::duration<double, std::nano> elapsed{};
+        for (std::size_t i = 0; i != iterations; ++i) {
+            setup();
+            const auto start = clock::now();
+            sink = sink + run();
+            elapsed += clock::now() - start;
+        }
+        return elapsed;
+    }
+}
+
+template <typename Setup, typename F>
+double measure(const options& opts, std::size_t items, Setup setup, F&& run)
+{
+    std::size_t iterations = 1;
+    while (time_runs(iterations, setup, run) < opts.min_time / 4
+           && iterations < std::size_t{ 1 } << 30) {
+        iterations *= 2;
+    }
+    std::vector<double> samples;
+    for (int r = 0; r != opts.repetitions; ++r) {
+        const auto elapsed = time_runs(iterations, setup, run);
+        samples.push_back(elapsed.count()
+                          / static_cast<double>(iterations * items));
+    }
+    auto median = samples.begin() + std::ssize(samples) / 2;
+    std::ranges::nth_element(samples, median);
+    return *median;
+}
+
+class runner {
+public:
+    explicit runner(const options& opts) : opts_(opts) {}
+
+    template <typename F>
+    void run(std::string_view algorithm,
+             std::string_view variant,
+             distribution d,
+             std::size_t size,
+             std::size_t items,
+             F&& f)
+    {
+        run(algorithm, variant, d, size, items, no_setup{}, f);
+    }
+
+    template <typename Setup, typename F>
+    void run(std::string_view algorithm,
+             std::string_view variant,
+             distribution d,
+             std::size_t size,
+             std::size_t items,
+             Setup setup,
+             F&& f)
+    {
+        const auto id = std::format("{}/{}/{}/{}",
+                                    algorithm,
+                                    variant,
+                                    name_of(d),
+                                    size);
+        if (!opts_.filter.empty() && !id.contains(opts_.filter)) {
+            return;
+        }
+        const auto ns = measure(opts_, items, setup, std::forward<F>(f));
+        std::cout << std::format("{:<48} {:>10.3f} ns/element\n", id, ns);
+        results_.push_back({ std::string(algorithm),
+                             std::string(variant),
+                             std::string(name_of(d)),
+                             size,
+                             ns });
+    }
+
+    const std::vector<result>& results() const { return results_; }
+
+private:
+    const options& opts_;
+    std::vector<result> results_;
+};
+
+void bench_find_if(runner& r,
+                   distribution d,
+                   const std::vector<record>& data)
+{
+    const auto n = data.size();
+    const std::int32_t needle = -1;
+    auto index = [&](auto it) {
+        return static_cast<std::size_t>(it - data.begin());
+    };
+    r.run("find_if", "composer", d, n, n, [&] {
+        return index(
+            composer::find_if(data, &record::num | composer::equal_to(needle)));
+    });
+    r.run("find_if", "composer_pipe", d, n, n, [&] {
+        return index(data
+                     | composer::find_if(&record::num
+                                         | composer::equal_to(needle)));
+    });
+    r.run("find_if", "lambda", d, n, n, [&] {
+        return index(std::ranges::find_if(
+            data, [needle](const record& x) { return x.num == needle; }));
+    });
+    r.run("find_if", "ranges_projection", d, n, n, [&] {
+        return index(std::ranges::find(data, needle, &record::num));
+    });
+    r.run("find_if", "raw_loop", d, n, n, [&] {
+        std::size_t i = 0;
+        while (i != n && data[i].num != needle) {
+            ++i;
+        }
+        return i;
+    });
+}
+
+void bench_count_if(runner& r,
+                    distribution d,
+                    const std::vector<record>& data)
+{
+    const auto n = data.size();
+    const std::int32_t needle = data[n / 2].num;
+    auto count = [](auto c) { return static_cast<std::size_t>(c); };
+    r.run("count_if", "composer", d, n, n, [&] {
+        return count(composer::count_if(data,
+                                        &record::num
+                                            | composer::equal_to(needle)));
+    });
+    r.run("count_if", "composer_pipe", d, n, n, [&] {
+        return count(data
+                     | composer::count_if(&record::num
+                                          | composer::equal_to(needle)));
+    });
+    r.run("count_if", "lambda", d, n, n, [&] {
+        return count(std::ranges::count_if(
+            data, [needle](const record& x) { return x.num == needle; }));
+    });
+    r.run("count_if", "ranges_projection", d, n, n, [&] {
+        return count(std::ranges::count(data, needle, &record::num));
+    });
+    r.run("count_if", "raw_loop", d, n, n, [&] {
+        std::size_t c = 0;
+        for (std::size_t i = 0; i != n; ++i) {
+            c += data[i].num == needle;
+        }
+        return c;
+    });
+}
+
+void bench_sort(runner& r, distribution d, const std::vector<record>& data)
+{
+    const auto n = data.size();
+    constexpr auto by_num = composer::transform_args(&record::num);
+    std::vector<record> work;
+    const auto restore = [&] { work = data; };
+    // composer::sort would radix sort, which is a different algorithm from
+    // the other rows, so the comparator is measured with std::ranges::sort.
+    r.run("sort", "composer", d, n, n, restore, [&] {
+        std::ranges::sort(work, by_num(composer::less_than));
+        return static_cast<std::size_t>(work.front().id);
+    });
+    r.run("sort", "radix_sort", d, n, n, restore, [&] {
+        composer::radix_sort(work, by_num(composer::less_than));
+        return static_cast<std::size_t>(work.front().id);
+    });
+    r.run("sort", "lambda", d, n, n, restore, [&] {
+        std::ranges::sort(work, [](const record& lh, const record& rh) {
+            return lh.num < rh.num;
+        });
+        return static_cast<std::size_t>(work.front().id);
+    });
+    r.run("sort", "ranges_projection", d, n, n, restore, [&] {
+        std::ranges::sort(work, {}, &record::num);
+        return static_cast<std::size_t>(work.front().id);
+    });
+    r.run("sort", "raw_loop", d, n, n, restore, [&] {
+        std::sort(work.begin(),
+                  work.end(),
+                  [](const record& lh, const record& rh) {
+                      return lh.num < rh.num;
+                  });
+        return static_cast<std::size_t>(work.front().id);
+    });
+}
+
+void bench_is_sorted(runner& r,
+                     distribution d,
+                     const std::vector<record>& sorted)
+{
+    const auto n = sorted.size();
+    constexpr auto by_num = composer::transform_args(&record::num);
+    r.run("is_sorted", "composer", d, n, n, [&] {
+        return std::size_t{ composer::is_sorted(sorted,
+                                                by_num(composer::less_than)) };
+    });
+    r.run("is_sorted", "composer_pipe", d, n, n, [&] {
+        return std::size_t{ sorted
+                            | composer::is_sorted(
+                                by_num(composer::less_than)) };
+    });
+    r.run("is_sorted", "lambda", d, n, n, [&] {
+        return std::size_t{ std::ranges::is_sorted(
+            sorted, [](const record& lh, const record& rh) {
+                return lh.num < rh.num;
+            }) };
+    });
+    r.run("is_sorted", "ranges_projection", d, n, n, [&] {
+        return std::size_t{ std::ranges::is_sorted(sorted, {}, &record::num) };
+    });
+    r.run("is_sorted", "raw_loop", d, n, n, [&] {
+        std::size_t i = 1;
+        while (i < n && !(sorted[i].num < sorted[i - 1].num)) {
+            ++i;
+        }
+        return std::size_t{ i >= n };
+    });
+}
+
+void bench_lower_bound(runner& r,
+                       distribution d,
+                       const std::vector<record>& sorted,
+                       std::mt19937_64& rng)
+{
+    const auto n = sorted.size();
+    std::vector<std::int32_t> queries(1024);
+    std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+    std::ranges::generate(queries, [&] { return sorted[pick(rng)].num; });
+    const auto items = queries.size();
+    auto index = [&](auto it) {
+        return static_cast<std::size_t>(it - sorted.begin());
+    };
+    r.run("lower_bound", "composer", d, n, items, [&] {
+        std::size_t sum = 0;
+        for (auto q : queries) {
+            sum += index(composer::lower_bound(sorted,
+                                               q,
+                                               composer::less_than,
+                                               &record::num));
+        }
+        return sum;
+    });
+    r.run("lower_bound", "composer_pipe", d, n, items, [&] {
+        std::size_t sum = 0;
+        for (auto q : queries) {
+            sum += index(sorted
+                         | composer::lower_bound(q,
+                                                 composer::less_than,
+                                                 &record::num));
+        }
+        return sum;
+    });
+    r.run("lower_bound", "lambda", d, n, items, [&] {
+        std::size_t sum = 0;
+        for (auto q : queries) {
+            sum += index(std::lower_bound(
+                sorted.begin(),
+                sorted.end(),
+                q,
+                [](const record& x, std::int32_t v) { return x.num < v; }));
+        }
+        return sum;
+    });
+    r.run("lower_bound", "ranges_projection", d, n, items, [&] {
+        std::size_t sum = 0;
+        for (auto q : queries) {
+            sum += index(std::ranges::lower_bound(sorted, q, {}, &record::num));
+        }
+        return sum;
+    });
+    r.run("lower_bound", "raw_loop", d, n, items, [&] {
+        std::size_t sum = 0;
+        for (auto q : queries) {
+            std::size_t first = 0;
+            std::size_t count = n;
+            while (count > 0) {
+                const auto half = count / 2;
+                if (sorted[first + half].num < q) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            sum += first;
+        }
+        return sum;
+    });
+}
+
+std::string to_json(const result& res)
+{
+    return std::format("{{\"algorithm\": \"{}\", \"variant\": \"{}\", "
+                       "\"distribution\": \"{}\", \"size\": {}, "
+                       "\"ns_per_element\": {:.6f}}}",
+                       res.algorithm,
+                       res.variant,
+                       res.distribution,
+                       res.size,
+                       res.ns_per_element);
+}
+
+std::string compiler_id()
+{
+#if defined(__clang__)
+    return std::format("clang-{}.{}", __clang_major__, __clang_minor__);
+#elif defined(__GNUC__)
+    return std::format("gcc-{}.{}", __GNUC__, __GNUC_MINOR__);
+#elif defined(_MSC_VER)
+    return std::format("msvc-{}", _MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+void write_results(const options& opts, const std::vector<result>& results)
+{
+    std::ofstream os(opts.output);
+    os << "{\n\"compiler\": \"" << compiler_id() << "\",\n\"results\": [\n";
+    const char* separator = "";
+    for (const auto& res : results) {
+        os << std::exchange(separator, ",\n") << to_json(res);
+    }
+    os << "\n]\n}\n";
+}
+
+std::string_view string_field(std::string_view line, std::string_view key)
+{
+    const auto tag = std::format("\"{}\": \"", key);
+    const auto pos = line.find(tag);
+    if (pos == std::string_view::npos) {
+        return {};
+    }
+    line.remove_prefix(pos + tag.size());
+    return line.substr(0, line.find('"'));
+}
+
+double number_field(std::string_view line, std::string_view key)
+{
+    const auto tag = std::format("\"{}\": ", key);
+    const auto pos = line.find(tag);
+    double value = -1.0;
+    if (pos != std::string_view::npos) {
+        line.remove_prefix(pos + tag.size());
+        std::from_chars(line.data(), line.data() + line.size(), value);
+    }
+    return value;
+}
+
+std::vector<result> read_results(const std::string& path)
+{
+    std::ifstream is(path);
+    if (!is) {
+        throw std::runtime_error(std::format("Can't read baseline {}", path));
+    }
+    std::vector<result> results;
+    std::string line;
+    while (std::getline(is, line)) {
+        const auto algorithm = string_field(line, "algorithm");
+        if (algorithm.empty()) {
+            continue;
+        }
+        results.push_back(
+            { std::string(algorithm),
+              std::string(string_field(line, "variant")),
+              std::string(string_field(line, "distribution")),
+              static_cast<std::size_t>(number_field(line, "size")),
+              number_field(line, "ns_per_element") });
+    }
+    return results;
+}
+
+bool same_case(const result& lh, const result& rh)
+{
+    return lh.algorithm == rh.algorithm && lh.distribution == rh.distribution
+        && lh.size == rh.size;
+}
+
+int compare_to_baseline(const options& opts,
+                        const std::vector<result>& results)
+{
+    const auto baseline = read_results(opts.baseline);
+    int regressions = 0;
+    for (const auto& res : results) {
+        auto old = std::ranges::find_if(baseline, [&](const result& b) {
+            return same_case(b, res) && b.variant == res.variant;
+        });
+        if (old == baseline.end() || old->ns_per_element <= 0.0) {
+            continue;
+        }
+        const auto change = res.ns_per_element / old->ns_per_element - 1.0;
+        if (change > opts.tolerance) {
+            std::cout << std::format(
+                "REGRESSION {}/{}/{}/{}: {:.3f} -> {:.3f} ns/element "
+                "(+{:.1f}%)\n",
+                res.algorithm,
+                res.variant,
+                res.distribution,
+                res.size,
+                old->ns_per_element,
+                res.ns_per_element,
+                change * 100.0);
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+int check_overhead(const options& opts, const std::vector<result>& results)
+{
+    int violations = 0;
+    for (const auto& res : results) {
+        if (!res.variant.starts_with("composer")) {
+            continue;
+        }
+        auto reference = std::ranges::find_if(results, [&](const result& r) {
+            return same_case(r, res) && r.variant == "lambda";
+        });
+        if (reference == results.end()) {
+            continue;
+        }
+        const auto overhead = res.ns_per_element / reference->ns_per_element
+                            - 1.0;
+        if (overhead > opts.max_overhead) {
+            std::cout << std::format(
+                "OVERHEAD {}/{}/{}/{}: {:.1f}% slower than lambda\n",
+                res.algorithm,
+                res.variant,
+                res.distribution,
+                res.size,
+                overhead * 100.0);
+            ++violations;
+        }
+    }
+    return violations;
+}
+
+template <typename T>
+T parse_number(std::string_view text)
+{
+    T value{};
+    auto [ptr, ec] = std::from_chars(text.data(),
+                                     text.data() + text.size(),
+                                     value);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) {
+        throw std::invalid_argument(std::format("Bad number '{}'", text));
+    }
+    return value;
+}
+
+options parse_options(int argc, char* argv[])
+{
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto eq = arg.find('=');
+        const auto key = arg.substr(0, eq);
+        const auto value = eq == std::string_view::npos ? std::string_view{}
+                                                        : arg.substr(eq + 1);
+        if (key == "--quick") {
+            opts.max_size = std::size_t{ 1 } << 16;
+            opts.min_time = std::chrono::milliseconds{ 10 };
+            opts.repetitions = 3;
+        } else if (key == "--min-size") {
+            opts.min_size = parse_number<std::size_t>(value);
+        } else if (key == "--max-size") {
+            opts.max_size = parse_number<std::size_t>(value);
+        } else if (key == "--min-time") {
+            opts.min_time = std::chrono::milliseconds{ parse_number<int>(
+                value) };
+        } else if (key == "--repetitions") {
+            opts.repetitions = parse_number<int>(value);
+        } else if (key == "--output") {
+            opts.output = value;
+        } else if (key == "--baseline") {
+            opts.baseline = value;
+        } else if (key == "--tolerance") {
+            opts.tolerance = parse_number<double>(value);
+        } else if (key == "--max-overhead") {
+            opts.max_overhead = parse_number<double>(value);
+        } else if (key == "--report-only") {
+            opts.report_only = true;
+        } else if (key == "--filter") {
+            opts.filter = value;
+        } else {
+            throw std::invalid_argument(
+                std::format("Unknown option '{}'\n"
+                            "usage: {} [--quick] [--min-size=N] "
+                            "[--max-size=N] [--min-time=ms] "
+                            "[--repetitions=N] [--output=file] "
+                            "[--baseline=file] [--tolerance=x] "
+                            "[--max-overhead=x] [--report-only] "
+                            "[--filter=text]",
+                            arg,
+                            argv[0]));
+        }
+    }
+    return opts;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        const auto opts = parse_options(argc, argv);
+        runner r(opts);
+        std::mt19937_64 rng(20251016);
+        for (auto n = opts.min_size; n <= opts.max_size; n *= 8) {
+            for (auto d : distributions) {
+                const auto data = make_data(d, n, rng);
+                auto sorted = data;
+                std::ranges::sort(sorted, {}, &record::num);
+                bench_find_if(r, d, data);
+                bench_count_if(r, d, data);
+                bench_sort(r, d, data);
+                bench_is_sorted(r, d, sorted);
+                bench_lower_bound(r, d, sorted, rng);
+            }
+        }
+        write_results(opts, r.results());
+        std::cout << "Results written to " << opts.output << '\n';
+
+        int failures = 0;
+        if (!opts.baseline.empty()) {
+            failures += compare_to_baseline(opts, r.results());
+        }
+        if (opts.max_overhead >= 0.0) {
+            failures += check_overhead(opts, r.results());
+        }
+        return failures == 0 || opts.report_only ? EXIT_SUCCESS
+                                                 : EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
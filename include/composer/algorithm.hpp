@@ -2,150 +2,1954 @@
 #define COMPOSER_ALGORITHM_HPP
 
 #include "back_binding.hpp"
+#include "execution.hpp"
+#include "learned_index.hpp"
+#include "radix_sort.hpp"
+#include "search_cursor.hpp"
+#include "search_index.hpp"
+#include "simd.hpp"
+#include "transform_args.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace composer {
 
-inline constexpr auto all_of = make_composable_function<back_binding>(
+namespace internal {
+
+template <typename I>
+constexpr I advanced(I first, std::size_t n)
+{
+    return first + static_cast<std::iter_difference_t<I>>(n);
+}
+
+template <typename R>
+std::size_t range_size(R& r)
+{
+    return static_cast<std::size_t>(std::ranges::size(r));
+}
+
+// Calls f(first, last) for one subrange of r per chunk.
+template <typename R, typename F>
+void parallel_subranges(executor& exec, R& r, const F& f)
+{
+    const auto first = std::ranges::begin(r);
+    parallel_chunks(exec,
+                    range_size(r),
+                    [&](std::size_t, std::size_t begin, std::size_t end) {
+                        f(advanced(first, begin), advanced(first, end));
+                    });
+}
+
+// Returns the results of f(first, last) for the subranges of r, in order.
+template <typename R, typename F>
+auto parallel_subrange_results(executor& exec, R& r, const F& f)
+{
+    using iterator = std::ranges::iterator_t<R>;
+    const auto first = std::ranges::begin(r);
+    const auto n = range_size(r);
+    std::vector<std::invoke_result_t<const F&, iterator, iterator>> results(
+        parallel_chunk_count(exec, n));
+    parallel_chunks(
+        exec, n, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            results[chunk] = f(advanced(first, begin), advanced(first, end));
+        });
+    return results;
+}
+
+template <typename T>
+struct equal_to_value {
+    const T& value;
+
+    template <typename U>
+    constexpr bool operator()(U&& u) const
+    {
+        return std::ranges::equal_to{}(std::forward<U>(u), value);
+    }
+};
+
+template <typename I, typename Pred, typename Proj>
+I find_in(I first, I last, const Pred& pred, const Proj& proj)
+{
+    return vectorized_or<vectorized_find_if>(
+        std::ranges::find_if, first, last, pred, proj);
+}
+
+template <typename I, typename T>
+I find_in(I first, I last, const equal_to_value<T>& pred, std::identity proj)
+{
+    return vectorized_or<vectorized_find>(
+        std::ranges::find, first, last, pred.value, proj);
+}
+
+// Returns the index of the first element of r for which pred is true, or the
+// size of r. Chunks are searched a block at a time, so that a chunk can stop
+// when a match has been found in an earlier chunk.
+template <typename R, typename Pred, typename Proj>
+std::size_t parallel_find_index(executor& exec,
+                                R& r,
+                                const Pred& pred,
+                                const Proj& proj)
+{
+    constexpr std::size_t block_size = 4096;
+    const auto first = std::ranges::begin(r);
+    const auto n = range_size(r);
+    std::atomic<std::size_t> found = n;
+    parallel_chunks(
+        exec, n, [&](std::size_t, std::size_t begin, std::size_t end) {
+            while (begin < end
+                   && begin < found.load(std::memory_order_relaxed)) {
+                const auto last = std::min(end, begin + block_size);
+                const auto i = find_in(
+                    advanced(first, begin), advanced(first, last), pred, proj);
+                if (i != advanced(first, last)) {
+                    const auto index = static_cast<std::size_t>(i - first);
+                    auto current = found.load(std::memory_order_relaxed);
+                    while (index < current
+                           && !found.compare_exchange_weak(
+                               current, index, std::memory_order_relaxed)) {
+                    }
+                    return;
+                }
+                begin = last;
+            }
+        });
+    return found.load();
+}
+
+template <typename Pred>
+struct negated {
+    const Pred& pred;
+
+    template <typename U>
+    constexpr bool operator()(U&& u) const
+    {
+        return !std::invoke(pred, std::forward<U>(u));
+    }
+};
+
+template <typename R, typename Proj>
+using projected_t = std::projected<std::ranges::iterator_t<R>, Proj>;
+
+struct parallel_find_if {
+    template <parallel_range R, typename Pred, typename Proj = std::identity>
+        requires std::indirect_unary_predicate<Pred, projected_t<R, Proj>>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec, R&& r, Pred pred, Proj proj = {}) const
+    {
+        return advanced(std::ranges::begin(r),
+                        parallel_find_index(exec, r, pred, proj));
+    }
+};
+
+struct parallel_find_if_not {
+    template <parallel_range R, typename Pred, typename Proj = std::identity>
+        requires std::indirect_unary_predicate<Pred, projected_t<R, Proj>>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec, R&& r, Pred pred, Proj proj = {}) const
+    {
+        return advanced(
+            std::ranges::begin(r),
+            parallel_find_index(exec, r, negated<Pred>{ pred }, proj));
+    }
+};
+
+struct parallel_find {
+    template <parallel_range R, typename T, typename Proj = std::identity>
+        requires std::indirect_binary_predicate<std::ranges::equal_to,
+                                                projected_t<R, Proj>,
+                                                const T*>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec, R&& r, const T& value, Proj proj = {}) const
+    {
+        return advanced(
+            std::ranges::begin(r),
+            parallel_find_index(exec, r, equal_to_value<T>{ value }, proj));
+    }
+};
+
+struct parallel_contains {
+    template <parallel_range R, typename T, typename Proj = std::identity>
+        requires std::indirect_binary_predicate<std::ranges::equal_to,
+                                                projected_t<R, Proj>,
+                                                const T*>
+    bool operator()(executor& exec, R&& r, const T& value, Proj proj = {}) const
+    {
+        return parallel_find_index(exec, r, equal_to_value<T>{ value }, proj)
+            != range_size(r);
+    }
+};
+
+struct parallel_any_of {
+    template <parallel_range R, typename Pred, typename Proj = std::identity>
+        requires std::indirect_unary_predicate<Pred, projected_t<R, Proj>>
+    bool operator()(executor& exec, R&& r, Pred pred, Proj proj = {}) const
+    {
+        return parallel_find_index(exec, r, pred, proj) != range_size(r);
+    }
+};
+
+struct parallel_all_of {
+    template <parallel_range R, typename Pred, typename Proj = std::identity>
+        requires std::indirect_unary_predicate<Pred, projected_t<R, Proj>>
+    bool operator()(executor& exec, R&& r, Pred pred, Proj proj = {}) const
+    {
+        return parallel_find_index(exec, r, negated<Pred>{ pred }, proj)
+            == range_size(r);
+    }
+};
+
+struct parallel_none_of {
+    template <parallel_range R, typename Pred, typename Proj = std::identity>
+        requires std::indirect_unary_predicate<Pred, projected_t<R, Proj>>
+    bool operator()(executor& exec, R&& r, Pred pred, Proj proj = {}) const
+    {
+        return parallel_find_index(exec, r, pred, proj) == range_size(r);
+    }
+};
+
+struct parallel_count_if {
+    template <parallel_range R, typename Pred, typename Proj = std::identity>
+        requires std::indirect_unary_predicate<Pred, projected_t<R, Proj>>
+    std::ranges::range_difference_t<R>
+    operator()(executor& exec, R&& r, Pred pred, Proj proj = {}) const
+    {
+        const auto counts = parallel_subrange_results(
+            exec, r, [&](auto first, auto last) {
+                return vectorized_or<vectorized_count_if>(
+                    std::ranges::count_if, first, last, pred, proj);
+            });
+        return std::accumulate(counts.begin(),
+                               counts.end(),
+                               std::ranges::range_difference_t<R>{});
+    }
+};
+
+struct parallel_count {
+    template <parallel_range R, typename T, typename Proj = std::identity>
+        requires std::indirect_binary_predicate<std::ranges::equal_to,
+                                                projected_t<R, Proj>,
+                                                const T*>
+    std::ranges::range_difference_t<R>
+    operator()(executor& exec, R&& r, const T& value, Proj proj = {}) const
+    {
+        const auto counts = parallel_subrange_results(
+            exec, r, [&](auto first, auto last) {
+                return vectorized_or<vectorized_count>(
+                    std::ranges::count, first, last, value, proj);
+            });
+        return std::accumulate(counts.begin(),
+                               counts.end(),
+                               std::ranges::range_difference_t<R>{});
+    }
+};
+
+struct parallel_for_each {
+    template <parallel_range R, typename Fun, typename Proj = std::identity>
+        requires std::indirectly_unary_invocable<Fun, projected_t<R, Proj>>
+    std::ranges::for_each_result<std::ranges::borrowed_iterator_t<R>, Fun>
+    operator()(executor& exec, R&& r, Fun f, Proj proj = {}) const
+    {
+        parallel_subranges(exec, r, [&](auto first, auto last) {
+            std::ranges::for_each(first, last, std::ref(f), proj);
+        });
+        return { advanced(std::ranges::begin(r), range_size(r)),
+                 std::move(f) };
+    }
+};
+
+struct parallel_fill {
+    template <parallel_range R, typename T>
+        requires std::ranges::output_range<R, const T&>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec, R&& r, const T& value) const
+    {
+        parallel_subranges(exec, r, [&](auto first, auto last) {
+            std::ranges::fill(first, last, value);
+        });
+        return advanced(std::ranges::begin(r), range_size(r));
+    }
+};
+
+struct parallel_replace {
+    template <parallel_range R,
+              typename T1,
+              typename T2,
+              typename Proj = std::identity>
+        requires std::indirectly_writable<std::ranges::iterator_t<R>,
+                                          const T2&>
+              && std::indirect_binary_predicate<std::ranges::equal_to,
+                                                projected_t<R, Proj>,
+                                                const T1*>
+    std::ranges::borrowed_iterator_t<R> operator()(executor& exec,
+                                                   R&& r,
+                                                   const T1& old_value,
+                                                   const T2& new_value,
+                                                   Proj proj = {}) const
+    {
+        parallel_subranges(exec, r, [&](auto first, auto last) {
+            std::ranges::replace(first, last, old_value, new_value, proj);
+        });
+        return advanced(std::ranges::begin(r), range_size(r));
+    }
+};
+
+struct parallel_replace_if {
+    template <parallel_range R,
+              typename Pred,
+              typename T,
+              typename Proj = std::identity>
+        requires std::indirectly_writable<std::ranges::iterator_t<R>, const T&>
+              && std::indirect_unary_predicate<Pred, projected_t<R, Proj>>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec,
+               R&& r,
+               Pred pred,
+               const T& new_value,
+               Proj proj = {}) const
+    {
+        parallel_subranges(exec, r, [&](auto first, auto last) {
+            std::ranges::replace_if(first, last, pred, new_value, proj);
+        });
+        return advanced(std::ranges::begin(r), range_size(r));
+    }
+};
+
+// The chunk results are combined in order, so that ties are resolved like
+// the serial algorithms do: the first smallest and the first largest element,
+// except for minmax_element, which finds the last largest element.
+
+struct parallel_min_element {
+    template <parallel_range R,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires std::indirect_strict_weak_order<Comp, projected_t<R, Proj>>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec, R&& r, Comp comp = {}, Proj proj = {}) const
+    {
+        const auto results = parallel_subrange_results(
+            exec, r, [&](auto first, auto last) {
+                return std::ranges::min_element(first, last, comp, proj);
+            });
+        auto best = results.front();
+        for (const auto& i : results) {
+            if (std::invoke(comp, std::invoke(proj, *i),
+                            std::invoke(proj, *best))) {
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+
+struct parallel_max_element {
+    template <parallel_range R,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires std::indirect_strict_weak_order<Comp, projected_t<R, Proj>>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec, R&& r, Comp comp = {}, Proj proj = {}) const
+    {
+        const auto results = parallel_subrange_results(
+            exec, r, [&](auto first, auto last) {
+                return std::ranges::max_element(first, last, comp, proj);
+            });
+        auto best = results.front();
+        for (const auto& i : results) {
+            if (std::invoke(comp, std::invoke(proj, *best),
+                            std::invoke(proj, *i))) {
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+
+struct parallel_minmax_element {
+    template <parallel_range R,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires std::indirect_strict_weak_order<Comp, projected_t<R, Proj>>
+    std::ranges::minmax_element_result<std::ranges::borrowed_iterator_t<R>>
+    operator()(executor& exec, R&& r, Comp comp = {}, Proj proj = {}) const
+    {
+        const auto results = parallel_subrange_results(
+            exec, r, [&](auto first, auto last) {
+                return std::ranges::minmax_element(first, last, comp, proj);
+            });
+        auto best = results.front();
+        for (const auto& [min, max] : results) {
+            if (std::invoke(comp, std::invoke(proj, *min),
+                            std::invoke(proj, *best.min))) {
+                best.min = min;
+            }
+            if (!std::invoke(comp, std::invoke(proj, *max),
+                             std::invoke(proj, *best.max))) {
+                best.max = max;
+            }
+        }
+        return { best.min, best.max };
+    }
+};
+
+// The key caching algorithms call key once per element, instead of once per
+// comparison, by comparing copies of the keys. A key that is returned by
+// reference is cheap to get again, so it is not copied, and the algorithms
+// compare through the projection as usual.
+
+template <typename I, typename Key>
+using key_result_t = std::indirect_result_t<Key&, I>;
+
+template <typename I, typename Key>
+concept cached_key
+    = !std::is_reference_v<key_result_t<I, Key>>
+   && std::movable<key_result_t<I, Key>>;
+
+// Moves the elements from first + order[i] to first + i, for all i.
+template <typename I>
+constexpr void apply_permutation(I first, std::vector<std::size_t>& order)
+{
+    for (std::size_t i = 0; i != order.size(); ++i) {
+        if (order[i] == i) {
+            continue;
+        }
+        auto held = std::ranges::iter_move(advanced(first, i));
+        std::size_t hole = i;
+        while (order[hole] != i) {
+            const auto next = order[hole];
+            *advanced(first, hole)
+                = std::ranges::iter_move(advanced(first, next));
+            order[hole] = hole;
+            hole = next;
+        }
+        *advanced(first, hole) = std::move(held);
+        order[hole] = hole;
+    }
+}
+
+// Radix sorts the n elements from first by proj. Integers and enums that are
+// sorted by themselves are sorted directly, and anything else is sorted by
+// the order of its keys.
+template <typename Comp, typename I, typename Proj>
+void radix_sort_n(I first, std::size_t n, Proj& proj)
+{
+    constexpr int direction = radix_direction<predicate_core_t<Comp>>;
+    using value_type = std::iter_value_t<I>;
+    if constexpr (std::same_as<Proj, std::identity>
+                  && !std::floating_point<value_type>
+                  && std::same_as<std::remove_cvref_t<std::iter_reference_t<I>>,
+                                  value_type>) {
+        radix_sort_values<direction>(first, n);
+    } else {
+        auto order = radix_sorted_order<direction>(first, n, proj);
+        apply_permutation(first, order);
+    }
+}
+
+// Sorts with radix sort when the comparison is less or greater over integer,
+// enum or floating point keys, either as comp and proj or as a comparison
+// made with transform_args. Ranges shorter than Threshold, and ranges sorted
+// in constant evaluation, are sorted by comparisons instead, stably if Stable
+// is true. Radix sort is stable.
+template <bool Stable, std::size_t Threshold = radix_sort_threshold>
+struct radix_sorter {
+    template <std::ranges::random_access_range R,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+              && radix_sortable<std::ranges::iterator_t<R>, Comp, Proj>
+    constexpr std::ranges::borrowed_iterator_t<R>
+    operator()(R&& r, Comp comp = {}, Proj proj = {}) const
+    {
+        const auto first = std::ranges::begin(r);
+        const auto last = std::ranges::next(first, std::ranges::end(r));
+        const auto n = static_cast<std::size_t>(last - first);
+        if !consteval {
+            if (n >= Threshold) {
+                radix_sort_n<Comp>(first, n, proj);
+                return last;
+            }
+        }
+        if constexpr (Stable) {
+            std::ranges::stable_sort(first, last, comp, proj);
+        } else {
+            std::ranges::sort(first, last, comp, proj);
+        }
+        return last;
+    }
+
+    template <std::ranges::random_access_range R, key_comparison C>
+    constexpr auto operator()(R&& r, const C& comp) const
+        -> decltype((*this)(std::forward<R>(r), comp.f.f, comp.f.t))
+    {
+        return (*this)(std::forward<R>(r), comp.f.f, comp.f.t);
+    }
+};
+
+template <bool Stable>
+struct key_cached_sort {
+    template <std::ranges::random_access_range R,
+              typename Key,
+              typename Comp = std::ranges::less>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Key>
+    constexpr std::ranges::borrowed_iterator_t<R>
+    operator()(R&& r, Key key, Comp comp = {}) const
+    {
+        using iterator = std::ranges::iterator_t<R>;
+        const auto first = std::ranges::begin(r);
+        const auto last = std::ranges::next(first, std::ranges::end(r));
+        if constexpr (radix_sortable<iterator, Comp, Key>) {
+            if !consteval {
+                const auto n = static_cast<std::size_t>(last - first);
+                if (n >= radix_sort_threshold) {
+                    radix_sort_n<Comp>(first, n, key);
+                    return last;
+                }
+            }
+        }
+        if constexpr (!cached_key<iterator, Key>) {
+            if constexpr (Stable) {
+                std::ranges::stable_sort(first, last, comp, key);
+            } else {
+                std::ranges::sort(first, last, comp, key);
+            }
+        } else {
+            using decorated
+                = std::pair<key_result_t<iterator, Key>, std::size_t>;
+            std::vector<decorated> keys;
+            keys.reserve(static_cast<std::size_t>(last - first));
+            for (auto i = first; i != last; ++i) {
+                keys.emplace_back(std::invoke(key, *i), keys.size());
+            }
+            if constexpr (Stable) {
+                std::ranges::stable_sort(keys, comp, &decorated::first);
+            } else {
+                std::ranges::sort(keys, comp, &decorated::first);
+            }
+            std::vector<std::size_t> order;
+            order.reserve(keys.size());
+            for (const auto& k : keys) {
+                order.push_back(k.second);
+            }
+            apply_permutation(first, order);
+        }
+        return last;
+    }
+
+    template <std::ranges::random_access_range R, key_comparison C>
+    constexpr auto operator()(R&& r, const C& comp) const
+        -> decltype((*this)(std::forward<R>(r), comp.f.t, comp.f.f))
+    {
+        return (*this)(std::forward<R>(r), comp.f.t, comp.f.f);
+    }
+};
+
+struct key_cached_is_sorted_until {
+    template <std::ranges::forward_range R,
+              typename Key,
+              typename Comp = std::ranges::less>
+        requires std::indirect_strict_weak_order<
+            Comp,
+            std::projected<std::ranges::iterator_t<R>, Key>>
+    constexpr std::ranges::borrowed_iterator_t<R>
+    operator()(R&& r, Key key, Comp comp = {}) const
+    {
+        using iterator = std::ranges::iterator_t<R>;
+        if constexpr (!cached_key<iterator, Key>) {
+            return std::ranges::is_sorted_until(r, comp, key);
+        } else {
+            auto i = std::ranges::begin(r);
+            const auto last = std::ranges::end(r);
+            if (i == last) {
+                return i;
+            }
+            auto previous = std::invoke(key, *i);
+            while (++i != last) {
+                auto current = std::invoke(key, *i);
+                if (std::invoke(comp, current, previous)) {
+                    return i;
+                }
+                previous = std::move(current);
+            }
+            return i;
+        }
+    }
+
+    template <std::ranges::forward_range R, key_comparison C>
+    constexpr auto operator()(R&& r, const C& comp) const
+        -> decltype((*this)(std::forward<R>(r), comp.f.t, comp.f.f))
+    {
+        return (*this)(std::forward<R>(r), comp.f.t, comp.f.f);
+    }
+};
+
+struct key_cached_adjacent_find {
+    template <std::ranges::forward_range R,
+              typename Key,
+              typename Pred = std::ranges::equal_to>
+        requires std::indirect_binary_predicate<
+            Pred,
+            std::projected<std::ranges::iterator_t<R>, Key>,
+            std::projected<std::ranges::iterator_t<R>, Key>>
+    constexpr std::ranges::borrowed_iterator_t<R>
+    operator()(R&& r, Key key, Pred pred = {}) const
+    {
+        using iterator = std::ranges::iterator_t<R>;
+        if constexpr (!cached_key<iterator, Key>) {
+            return std::ranges::adjacent_find(r, pred, key);
+        } else {
+            auto i = std::ranges::begin(r);
+            const auto last = std::ranges::end(r);
+            if (i == last) {
+                return i;
+            }
+            auto previous = std::invoke(key, *i);
+            auto next = std::ranges::next(i);
+            for (; next != last; i = next, ++next) {
+                auto current = std::invoke(key, *next);
+                if (std::invoke(pred, previous, current)) {
+                    return i;
+                }
+                previous = std::move(current);
+            }
+            return next;
+        }
+    }
+
+    template <std::ranges::forward_range R, key_comparison C>
+    constexpr auto operator()(R&& r, const C& pred) const
+        -> decltype((*this)(std::forward<R>(r), pred.f.t, pred.f.f))
+    {
+        return (*this)(std::forward<R>(r), pred.f.t, pred.f.f);
+    }
+};
+
+// Calls Specialized with ts, if it accepts them, and fallback otherwise.
+template <typename Specialized, typename Fallback, typename... Ts>
+    requires std::is_invocable_v<const Specialized&, Ts...>
+          || std::is_invocable_v<const Fallback&, Ts...>
+constexpr decltype(auto) specialized_or(const Fallback& fallback, Ts&&... ts)
+{
+    if constexpr (std::is_invocable_v<const Specialized&, Ts...>) {
+        return Specialized{}(std::forward<Ts>(ts)...);
+    } else {
+        return fallback(std::forward<Ts>(ts)...);
+    }
+}
+
+// The set operations below search the longer range with galloping search,
+// from where the previous search ended, instead of walking through it, when
+// it is at least galloping_ratio times as long as the other. A search that
+// skips d elements takes O(log d) comparisons, so m elements are found in n
+// with O(m log(n / m)) comparisons instead of O(m + n). Otherwise they call
+// the std::ranges algorithms.
+inline constexpr std::size_t galloping_ratio = 16;
+
+template <typename R>
+concept galloping_range
+    = std::ranges::random_access_range<R> && std::ranges::sized_range<R>;
+
+// Which of two ranges, with n1 and n2 elements, to gallop through, if any.
+enum class gallop_through { neither, first, second };
+
+constexpr gallop_through gallop_side(std::size_t n1, std::size_t n2)
+{
+    if (n2 * galloping_ratio <= n1) {
+        return gallop_through::first;
+    }
+    if (n1 * galloping_ratio <= n2) {
+        return gallop_through::second;
+    }
+    return gallop_through::neither;
+}
+
+template <typename R>
+constexpr std::size_t sized_length(R& r)
+{
+    return static_cast<std::size_t>(std::ranges::size(r));
+}
+
+struct galloping_set_intersection {
+    template <galloping_range R1,
+              galloping_range R2,
+              std::weakly_incrementable O,
+              typename Comp = std::ranges::less,
+              typename Proj1 = std::identity,
+              typename Proj2 = std::identity>
+        requires std::mergeable<std::ranges::iterator_t<R1>,
+                                std::ranges::iterator_t<R2>,
+                                O,
+                                Comp,
+                                Proj1,
+                                Proj2>
+    constexpr std::ranges::set_intersection_result<
+        std::ranges::borrowed_iterator_t<R1>,
+        std::ranges::borrowed_iterator_t<R2>,
+        O>
+    operator()(R1&& r1,
+               R2&& r2,
+               O out,
+               Comp comp = {},
+               Proj1 proj1 = {},
+               Proj2 proj2 = {}) const
+    {
+        auto i1 = std::ranges::begin(r1);
+        auto i2 = std::ranges::begin(r2);
+        const auto last1 = advanced(i1, sized_length(r1));
+        const auto last2 = advanced(i2, sized_length(r2));
+        switch (gallop_side(sized_length(r1), sized_length(r2))) {
+        case gallop_through::first:
+            for (; i2 != last2; ++i2) {
+                const auto& key = std::invoke(proj2, *i2);
+                i1 = gallop(i1, last1, [&](auto&& x) {
+                    return std::invoke(comp, std::invoke(proj1, x), key);
+                });
+                if (i1 == last1) {
+                    break;
+                }
+                if (!std::invoke(comp, key, std::invoke(proj1, *i1))) {
+                    *out = *i1;
+                    ++out;
+                    ++i1;
+                }
+            }
+            break;
+        case gallop_through::second:
+            for (; i1 != last1; ++i1) {
+                const auto& key = std::invoke(proj1, *i1);
+                i2 = gallop(i2, last2, [&](auto&& y) {
+                    return std::invoke(comp, std::invoke(proj2, y), key);
+                });
+                if (i2 == last2) {
+                    break;
+                }
+                if (!std::invoke(comp, key, std::invoke(proj2, *i2))) {
+                    *out = *i1;
+                    ++out;
+                    ++i2;
+                }
+            }
+            break;
+        case gallop_through::neither:
+            return std::ranges::set_intersection(
+                r1, r2, std::move(out), comp, proj1, proj2);
+        }
+        return { last1, last2, std::move(out) };
+    }
+};
+
+struct galloping_set_difference {
+    template <galloping_range R1,
+              galloping_range R2,
+              std::weakly_incrementable O,
+              typename Comp = std::ranges::less,
+              typename Proj1 = std::identity,
+              typename Proj2 = std::identity>
+        requires std::mergeable<std::ranges::iterator_t<R1>,
+                                std::ranges::iterator_t<R2>,
+                                O,
+                                Comp,
+                                Proj1,
+                                Proj2>
+    constexpr std::ranges::
+        set_difference_result<std::ranges::borrowed_iterator_t<R1>, O>
+        operator()(R1&& r1,
+                   R2&& r2,
+                   O out,
+                   Comp comp = {},
+                   Proj1 proj1 = {},
+                   Proj2 proj2 = {}) const
+    {
+        auto i1 = std::ranges::begin(r1);
+        auto i2 = std::ranges::begin(r2);
+        const auto last1 = advanced(i1, sized_length(r1));
+        const auto last2 = advanced(i2, sized_length(r2));
+        switch (gallop_side(sized_length(r1), sized_length(r2))) {
+        case gallop_through::first:
+            // Copies the elements of r1 up to each element of r2, and skips
+            // one equal element, if there is one.
+            for (; i2 != last2 && i1 != last1; ++i2) {
+                const auto& key = std::invoke(proj2, *i2);
+                const auto next = gallop(i1, last1, [&](auto&& x) {
+                    return std::invoke(comp, std::invoke(proj1, x), key);
+                });
+                out = std::ranges::copy(i1, next, std::move(out)).out;
+                i1 = next;
+                if (i1 != last1
+                    && !std::invoke(comp, key, std::invoke(proj1, *i1))) {
+                    ++i1;
+                }
+            }
+            out = std::ranges::copy(i1, last1, std::move(out)).out;
+            break;
+        case gallop_through::second:
+            for (; i1 != last1; ++i1) {
+                const auto& key = std::invoke(proj1, *i1);
+                i2 = gallop(i2, last2, [&](auto&& y) {
+                    return std::invoke(comp, std::invoke(proj2, y), key);
+                });
+                if (i2 != last2
+                    && !std::invoke(comp, key, std::invoke(proj2, *i2))) {
+                    ++i2;
+                } else {
+                    *out = *i1;
+                    ++out;
+                }
+            }
+            break;
+        case gallop_through::neither:
+            return std::ranges::set_difference(
+                r1, r2, std::move(out), comp, proj1, proj2);
+        }
+        return { last1, std::move(out) };
+    }
+};
+
+struct galloping_includes {
+    template <galloping_range R1,
+              galloping_range R2,
+              typename Proj1 = std::identity,
+              typename Proj2 = std::identity,
+              std::indirect_strict_weak_order<
+                  std::projected<std::ranges::iterator_t<R1>, Proj1>,
+                  std::projected<std::ranges::iterator_t<R2>, Proj2>> Comp
+              = std::ranges::less>
+    constexpr bool operator()(R1&& r1,
+                              R2&& r2,
+                              Comp comp = {},
+                              Proj1 proj1 = {},
+                              Proj2 proj2 = {}) const
+    {
+        // Every element of r2 needs an element of its own in r1.
+        if (sized_length(r2) > sized_length(r1)) {
+            return false;
+        }
+        if (gallop_side(sized_length(r1), sized_length(r2))
+            != gallop_through::first) {
+            return std::ranges::includes(r1, r2, comp, proj1, proj2);
+        }
+        auto i1 = std::ranges::begin(r1);
+        const auto last1 = advanced(i1, sized_length(r1));
+        for (auto&& y : r2) {
+            const auto& key = std::invoke(proj2, y);
+            i1 = gallop(i1, last1, [&](auto&& x) {
+                return std::invoke(comp, std::invoke(proj1, x), key);
+            });
+            if (i1 == last1
+                || std::invoke(comp, key, std::invoke(proj1, *i1))) {
+                return false;
+            }
+            ++i1;
+        }
+        return true;
+    }
+};
+
+struct galloping_merge {
+    template <galloping_range R1,
+              galloping_range R2,
+              std::weakly_incrementable O,
+              typename Comp = std::ranges::less,
+              typename Proj1 = std::identity,
+              typename Proj2 = std::identity>
+        requires std::mergeable<std::ranges::iterator_t<R1>,
+                                std::ranges::iterator_t<R2>,
+                                O,
+                                Comp,
+                                Proj1,
+                                Proj2>
+    constexpr std::ranges::merge_result<std::ranges::borrowed_iterator_t<R1>,
+                                        std::ranges::borrowed_iterator_t<R2>,
+                                        O>
+    operator()(R1&& r1,
+               R2&& r2,
+               O out,
+               Comp comp = {},
+               Proj1 proj1 = {},
+               Proj2 proj2 = {}) const
+    {
+        auto i1 = std::ranges::begin(r1);
+        auto i2 = std::ranges::begin(r2);
+        const auto last1 = advanced(i1, sized_length(r1));
+        const auto last2 = advanced(i2, sized_length(r2));
+        switch (gallop_side(sized_length(r1), sized_length(r2))) {
+        case gallop_through::first:
+            // Each element of r2 goes after the elements of r1 that are not
+            // greater than it.
+            for (; i2 != last2; ++i2) {
+                const auto& key = std::invoke(proj2, *i2);
+                const auto next = gallop(i1, last1, [&](auto&& x) {
+                    return !std::invoke(comp, key, std::invoke(proj1, x));
+                });
+                out = std::ranges::copy(i1, next, std::move(out)).out;
+                i1 = next;
+                *out = *i2;
+                ++out;
+            }
+            out = std::ranges::copy(i1, last1, std::move(out)).out;
+            break;
+        case gallop_through::second:
+            // Each element of r1 goes before the elements of r2 that are not
+            // less than it.
+            for (; i1 != last1; ++i1) {
+                const auto& key = std::invoke(proj1, *i1);
+                const auto next = gallop(i2, last2, [&](auto&& y) {
+                    return std::invoke(comp, std::invoke(proj2, y), key);
+                });
+                out = std::ranges::copy(i2, next, std::move(out)).out;
+                i2 = next;
+                *out = *i1;
+                ++out;
+            }
+            out = std::ranges::copy(i2, last2, std::move(out)).out;
+            break;
+        case gallop_through::neither:
+            return std::ranges::merge(
+                r1, r2, std::move(out), comp, proj1, proj2);
+        }
+        return { last1, last2, std::move(out) };
+    }
+};
+
+// Moves the merge of [a, a_last) and [b, b_last) to out. Elements from a
+// come before equal elements from b, as with std::ranges::merge.
+template <typename I1, typename I2, typename O, typename Comp, typename Proj>
+void move_merge(
+    I1 a, I1 a_last, I2 b, I2 b_last, O out, Comp& comp, Proj& proj)
+{
+    while (a != a_last && b != b_last) {
+        if (std::invoke(comp, std::invoke(proj, *b), std::invoke(proj, *a))) {
+            *out = std::ranges::iter_move(b);
+            ++b;
+        } else {
+            *out = std::ranges::iter_move(a);
+            ++a;
+        }
+        ++out;
+    }
+    out = std::ranges::move(a, a_last, out).out;
+    std::ranges::move(b, b_last, out);
+}
+
+// Returns how many of the first d elements of the merge of the sorted ranges
+// [a, a + na) and [b, b + nb) come from a.
+template <typename I, typename Comp, typename Proj>
+std::size_t merge_split(I a,
+                        std::size_t na,
+                        I b,
+                        std::size_t nb,
+                        std::size_t d,
+                        Comp& comp,
+                        Proj& proj)
+{
+    std::size_t lo = d > nb ? d - nb : 0;
+    std::size_t hi = std::min(d, na);
+    while (lo < hi) {
+        const auto mid = lo + (hi - lo) / 2;
+        if (std::invoke(comp,
+                        std::invoke(proj, *advanced(b, d - mid - 1)),
+                        std::invoke(proj, *advanced(a, mid)))) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+// Merges the sorted runs of src, that start at bounds, pairwise into dst, and
+// returns the bounds of the merged runs. The output is split into chunks,
+// and each chunk merges the parts of the runs that end up in it, so that all
+// threads are busy in every round, also when only two runs are left. Where
+// the chunks start in the runs is found before any element is moved, since
+// moving changes the elements that the other chunks search.
+template <typename I, typename O, typename Comp, typename Proj>
+std::vector<std::size_t>
+parallel_merge_runs(executor& exec,
+                    I src,
+                    O dst,
+                    const std::vector<std::size_t>& bounds,
+                    Comp& comp,
+                    Proj& proj)
+{
+    std::vector<std::size_t> merged;
+    for (std::size_t run = 0; run + 1 < bounds.size(); run += 2) {
+        merged.push_back(bounds[run]);
+    }
+    merged.push_back(bounds.back());
+    const auto n = bounds.back();
+    const auto run_of = [&](std::size_t i) {
+        return static_cast<std::size_t>(std::ranges::upper_bound(merged, i)
+                                        - merged.begin() - 1);
+    };
+    // How many of the elements of the merged run before d come from its
+    // first run.
+    const auto split = [&](std::size_t run, std::size_t d) {
+        const auto lo = merged[run];
+        const auto mid = bounds[2 * run + 1];
+        const auto hi = merged[run + 1];
+        return merge_split(advanced(src, lo),
+                           mid - lo,
+                           advanced(src, mid),
+                           hi - mid,
+                           d - lo,
+                           comp,
+                           proj);
+    };
+    std::vector<std::size_t> splits(parallel_chunk_count(exec, n) + 1);
+    parallel_chunks(
+        exec, n, [&](std::size_t chunk, std::size_t begin, std::size_t) {
+            splits[chunk] = split(run_of(begin), begin);
+        });
+    const auto merge_chunk
+        = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+              for (auto run = run_of(begin); merged[run] < end; ++run) {
+                  const auto lo = merged[run];
+                  const auto mid = bounds[2 * run + 1];
+                  const auto hi = merged[run + 1];
+                  const auto d0 = std::max(begin, lo);
+                  const auto d1 = std::min(end, hi);
+                  const auto i0 = d0 == begin ? splits[chunk] : 0;
+                  const auto i1 = d1 == end && end != hi ? splits[chunk + 1]
+                                                         : mid - lo;
+                  move_merge(advanced(src, lo + i0),
+                             advanced(src, lo + i1),
+                             advanced(src, mid + (d0 - lo - i0)),
+                             advanced(src, mid + (d1 - lo - i1)),
+                             advanced(dst, d0),
+                             comp,
+                             proj);
+              }
+          };
+    parallel_chunks(exec, n, merge_chunk);
+    return merged;
+}
+
+// Moves the n elements from from to to, in parallel.
+template <typename I, typename O>
+void parallel_move(executor& exec, I from, std::size_t n, O to)
+{
+    parallel_chunks(
+        exec, n, [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::ranges::move(advanced(from, begin),
+                              advanced(from, end),
+                              advanced(to, begin));
+        });
+}
+
+// Storage for elements moved out of a range, allocated once for all of
+// them, without constructing any until they are moved in.
+template <typename T>
+class move_buffer {
+public:
+    move_buffer() = default;
+
+    // Moves the n elements from first into the buffer, in parallel when
+    // moving cannot throw. Otherwise one at a time, so that the elements
+    // moved so far are known, and destroyed if a move throws.
+    template <typename I>
+    move_buffer(executor& exec, I first, std::size_t n) : move_buffer()
+    {
+        data_ = std::allocator<T>{}.allocate(n);
+        capacity_ = n;
+        if constexpr (std::is_nothrow_constructible_v<
+                          T,
+                          std::iter_rvalue_reference_t<I>>) {
+            parallel_chunks(
+                exec, n, [&](std::size_t, std::size_t begin, std::size_t end) {
+                    for (auto i = begin; i != end; ++i) {
+                        std::construct_at(
+                            data_ + i,
+                            std::ranges::iter_move(advanced(first, i)));
+                    }
+                });
+            size_ = n;
+        } else {
+            for (; size_ != n; ++size_) {
+                std::construct_at(
+                    data_ + size_,
+                    std::ranges::iter_move(advanced(first, size_)));
+            }
+        }
+    }
+
+    move_buffer(move_buffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0))
+    {}
+
+    move_buffer& operator=(move_buffer&& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        return *this;
+    }
+
+    ~move_buffer()
+    {
+        if (data_ != nullptr) {
+            std::destroy_n(data_, size_);
+            std::allocator<T>{}.deallocate(data_, capacity_);
+        }
+    }
+
+    T* begin() const noexcept { return data_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+template <typename I>
+move_buffer<std::iter_value_t<I>>
+moved_to_buffer(executor& exec, I first, std::size_t n)
+{
+    return move_buffer<std::iter_value_t<I>>(exec, first, n);
+}
+
+// Sorts the chunks in parallel, with radix sort when it accepts the
+// arguments, and merges the sorted chunks pairwise, back and forth between
+// the range and a buffer. The merges are stable, so the sort is stable if
+// the chunks are sorted stably.
+template <bool Stable>
+struct parallel_sort {
+    template <parallel_range R,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+              && (!key_comparison<Comp>)
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec, R&& r, Comp comp = {}, Proj proj = {}) const
+    {
+        const auto first = std::ranges::begin(r);
+        const auto n = range_size(r);
+        std::vector<std::size_t> bounds(parallel_chunk_count(exec, n) + 1);
+        const auto sort_chunk
+            = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                  bounds[chunk + 1] = end;
+                  std::ranges::subrange run(advanced(first, begin),
+                                            advanced(first, end));
+                  if constexpr (Stable) {
+                      vectorized_or<radix_sorter<true>>(
+                          std::ranges::stable_sort, run, comp, proj);
+                  } else {
+                      vectorized_or<radix_sorter<false>>(
+                          std::ranges::sort, run, comp, proj);
+                  }
+              };
+        parallel_chunks(exec, n, sort_chunk);
+        if (bounds.size() > 2) {
+            auto buffer = moved_to_buffer(exec, first, n);
+            bool in_buffer = true;
+            while (bounds.size() > 2) {
+                if (in_buffer) {
+                    bounds = parallel_merge_runs(
+                        exec, buffer.begin(), first, bounds, comp, proj);
+                } else {
+                    bounds = parallel_merge_runs(
+                        exec, first, buffer.begin(), bounds, comp, proj);
+                }
+                in_buffer = !in_buffer;
+            }
+            if (in_buffer) {
+                parallel_move(exec, buffer.begin(), n, first);
+            }
+        }
+        return advanced(first, n);
+    }
+
+    template <parallel_range R, key_comparison C>
+    auto operator()(executor& exec, R&& r, const C& comp) const
+        -> decltype((*this)(exec, std::forward<R>(r), comp.f.f, comp.f.t))
+    {
+        return (*this)(exec, std::forward<R>(r), comp.f.f, comp.f.t);
+    }
+};
+
+// Partitions the elements into those less than, equal to and greater than a
+// pivot, in parallel, by moving them from a buffer to their part of the
+// range, and continues with the part that holds the nth element, until it
+// is small enough for std::ranges::nth_element. The pivot is picked from a
+// sorted sample, at the rank of the nth element, so that the part shrinks
+// fast.
+struct parallel_nth_element {
+    static constexpr std::size_t serial_size = std::size_t{ 1 } << 14;
+    static constexpr std::size_t sample_size = 127;
+
+    template <parallel_range R,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(executor& exec,
+               R&& r,
+               std::ranges::iterator_t<R> nth,
+               Comp comp = {},
+               Proj proj = {}) const
+    {
+        const auto first = std::ranges::begin(r);
+        const auto n = range_size(r);
+        const auto k = static_cast<std::size_t>(nth - first);
+        if (k >= n) {
+            return advanced(first, n);
+        }
+        move_buffer<std::iter_value_t<std::ranges::iterator_t<R>>> buffer;
+        std::size_t lo = 0;
+        std::size_t hi = n;
+        while (hi - lo > serial_size) {
+            if (buffer.empty()) {
+                buffer = moved_to_buffer(exec, first, n);
+            } else {
+                parallel_move(exec,
+                              advanced(first, lo),
+                              hi - lo,
+                              advanced(buffer.begin(), lo));
+            }
+            const auto src = advanced(buffer.begin(), lo);
+            const auto size = hi - lo;
+            std::array<std::size_t, sample_size> sample;
+            for (std::size_t i = 0; i != sample_size; ++i) {
+                sample[i] = (2 * i + 1) * size / (2 * sample_size);
+            }
+            std::ranges::sort(sample, [&](std::size_t a, std::size_t b) {
+                return std::invoke(comp,
+                                   std::invoke(proj, src[a]),
+                                   std::invoke(proj, src[b]));
+            });
+            const auto pick = sample[(k - lo) * sample_size / size];
+            std::ranges::iter_swap(src, advanced(src, pick));
+            auto pivot = std::ranges::iter_move(src);
+            const auto [less, equal] = partition_three_way(exec,
+                                                           advanced(src, 1),
+                                                           size - 1,
+                                                           advanced(first, lo),
+                                                           pivot,
+                                                           comp,
+                                                           proj);
+            *advanced(first, lo + less) = std::move(pivot);
+            if (k < lo + less) {
+                hi = lo + less;
+            } else if (k <= lo + less + equal) {
+                return advanced(first, n);
+            } else {
+                lo += less + 1 + equal;
+            }
+        }
+        std::ranges::nth_element(advanced(first, lo),
+                                 nth,
+                                 advanced(first, hi),
+                                 comp,
+                                 proj);
+        return advanced(first, n);
+    }
+
+    // Moves the n elements from src to dst, those less than pivot first, then
+    // those equal to it, after a gap of one for the pivot, and then those
+    // greater than it. Returns the number of less and equal elements.
+    template <typename I, typename O, typename T, typename Comp, typename Proj>
+    static std::pair<std::size_t, std::size_t>
+    partition_three_way(executor& exec,
+                        I src,
+                        std::size_t n,
+                        O dst,
+                        const T& pivot,
+                        Comp& comp,
+                        Proj& proj)
+    {
+        const auto& key = std::invoke(proj, pivot);
+        const auto part = [&](const auto& x) -> std::size_t {
+            const auto& x_key = std::invoke(proj, x);
+            return std::invoke(comp, x_key, key)   ? 0
+                 : !std::invoke(comp, key, x_key) ? 1
+                                                   : 2;
+        };
+        std::vector<std::array<std::size_t, 3>> counts(
+            parallel_chunk_count(exec, n));
+        const auto count_chunk
+            = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                  for (auto i = begin; i != end; ++i) {
+                      ++counts[chunk][part(*advanced(src, i))];
+                  }
+              };
+        parallel_chunks(exec, n, count_chunk);
+        std::array<std::size_t, 3> totals{};
+        for (const auto& c : counts) {
+            for (std::size_t p = 0; p != 3; ++p) {
+                totals[p] += c[p];
+            }
+        }
+        std::array<std::size_t, 3> offset{ 0, totals[0] + 1,
+                                           totals[0] + 1 + totals[1] };
+        for (auto& c : counts) {
+            for (std::size_t p = 0; p != 3; ++p) {
+                c[p] = std::exchange(offset[p], offset[p] + c[p]);
+            }
+        }
+        const auto move_chunk
+            = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                  auto next = counts[chunk];
+                  for (auto i = begin; i != end; ++i) {
+                      const auto x = advanced(src, i);
+                      *advanced(dst, next[part(*x)]++)
+                          = std::ranges::iter_move(x);
+                  }
+              };
+        parallel_chunks(exec, n, move_chunk);
+        return { totals[0], totals[1] };
+    }
+};
+
+template <typename R, typename Comp, typename Proj>
+concept top_k_selectable
+    = std::ranges::input_range<R>
+   && std::constructible_from<std::ranges::range_value_t<R>,
+                              std::ranges::range_reference_t<R>>
+   && std::indirect_strict_weak_order<Comp,
+                                      std::projected<std::ranges::iterator_t<R>,
+                                                     Proj>>
+   && std::sortable<
+          std::ranges::iterator_t<std::vector<std::ranges::range_value_t<R>>>,
+          Comp,
+          Proj>;
+
+// Returns the k first elements of r in the order of comp, sorted, reading r
+// once. They are kept in a heap with the last of them on top, so each
+// element is compared with the top, and only replaces it if it comes before
+// it.
+struct bounded_top_k {
+    template <typename R,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires top_k_selectable<R, Comp, Proj>
+    constexpr std::vector<std::ranges::range_value_t<R>>
+    operator()(R&& r, std::size_t k, Comp comp = {}, Proj proj = {}) const
+    {
+        using value_type = std::ranges::range_value_t<R>;
+        std::vector<value_type> heap;
+        if (k == 0) {
+            return heap;
+        }
+        if constexpr (std::ranges::sized_range<R>) {
+            heap.reserve(
+                std::min(k, static_cast<std::size_t>(std::ranges::size(r))));
+        }
+        for (auto&& x : r) {
+            if (heap.size() < k) {
+                heap.emplace_back(std::forward<decltype(x)>(x));
+                std::ranges::push_heap(heap, comp, proj);
+            } else if (std::invoke(comp,
+                                   std::invoke(proj, x),
+                                   std::invoke(proj, heap.front()))) {
+                std::ranges::pop_heap(heap, comp, proj);
+                heap.back() = value_type(std::forward<decltype(x)>(x));
+                std::ranges::push_heap(heap, comp, proj);
+            }
+        }
+        std::ranges::sort_heap(heap, comp, proj);
+        return heap;
+    }
+};
+
+// Selects the top k of each chunk, and then the top k of those.
+struct parallel_top_k {
+    template <parallel_range R,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires top_k_selectable<R, Comp, Proj>
+    std::vector<std::ranges::range_value_t<R>> operator()(
+        executor& exec, R&& r, std::size_t k, Comp comp = {}, Proj proj = {})
+        const
+    {
+        auto parts = parallel_subrange_results(
+            exec, r, [&](auto first, auto last) {
+                return bounded_top_k{}(
+                    std::ranges::subrange(first, last), k, comp, proj);
+            });
+        std::vector<std::ranges::range_value_t<R>> tops;
+        for (auto& part : parts) {
+            std::ranges::move(part, std::back_inserter(tops));
+        }
+        if (tops.size() > k) {
+            const auto kth = advanced(tops.begin(), k);
+            std::ranges::partial_sort(tops, kth, comp, proj);
+            tops.erase(kth, tops.end());
+        } else {
+            std::ranges::sort(tops, comp, proj);
+        }
+        return tops;
+    }
+};
+
+template <typename H, typename Q, typename O, typename Comp, typename Proj>
+concept batch_searchable
+    = std::ranges::random_access_range<H> && std::ranges::sized_range<H>
+   && std::ranges::borrowed_range<H> && std::ranges::forward_range<Q>
+   && std::indirectly_writable<O, std::ranges::iterator_t<H>>
+   && std::indirect_strict_weak_order<
+          Comp,
+          std::projected<std::ranges::iterator_t<H>, Proj>,
+          std::ranges::iterator_t<Q>>;
+
+// Writes the lower bound in haystack of each of the queries to out. The
+// queries are searched for in groups, taking one step of the binary search
+// for each query of a group in turn, and prefetching the element that the
+// next step for the query reads, so that the cache misses of the group
+// overlap, instead of each search waiting for its own misses. All searches
+// take the same number of steps, since that depends only on the size of
+// haystack.
+struct batch_lower_bound {
+    static constexpr std::size_t group_size = 16;
+
+    template <typename H,
+              typename Q,
+              std::weakly_incrementable O,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires batch_searchable<H, Q, O, Comp, Proj>
+    std::ranges::in_out_result<std::ranges::borrowed_iterator_t<Q>, O>
+    operator()(H&& haystack,
+               Q&& queries,
+               O out,
+               Comp comp = {},
+               Proj proj = {}) const
+    {
+        const auto first = std::ranges::begin(haystack);
+        const auto n = range_size(haystack);
+        const auto before = [&](std::size_t i, const auto& query) {
+            return static_cast<bool>(std::invoke(
+                comp, std::invoke(proj, *advanced(first, i)), query));
+        };
+        const auto prefetch_at = [&](std::size_t i) {
+            if constexpr (std::contiguous_iterator<decltype(first)>) {
+                prefetch(std::to_address(advanced(first, i)));
+            }
+        };
+        auto query = std::ranges::begin(queries);
+        const auto last = std::ranges::end(queries);
+        std::array<std::ranges::iterator_t<Q>, group_size> group;
+        std::array<std::size_t, group_size> base;
+        while (query != last) {
+            std::size_t size = 0;
+            for (; size != group_size && query != last; ++size, ++query) {
+                group[size] = query;
+                base[size] = 0;
+            }
+            // The lower bound of group[i] is in [base[i], base[i] + length].
+            for (std::size_t length = n; length > 1;) {
+                const std::size_t half = length / 2;
+                const std::size_t next_half = (length - half) / 2;
+                // The element that the next step for a query reads.
+                const std::size_t next = next_half == 0 ? 0 : next_half - 1;
+                for (std::size_t i = 0; i != size; ++i) {
+                    base[i] += before(base[i] + half - 1, *group[i]) ? half : 0;
+                    prefetch_at(base[i] + next);
+                }
+                length -= half;
+            }
+            for (std::size_t i = 0; i != size; ++i) {
+                const bool after = n != 0 && before(base[i], *group[i]);
+                *out = advanced(first, base[i] + (after ? 1 : 0));
+                ++out;
+            }
+        }
+        return { std::move(query), std::move(out) };
+    }
+};
+
+// Searches for a chunk of the queries per thread, writing the results of
+// each chunk to its part of out.
+struct parallel_batch_lower_bound {
+    template <typename H,
+              parallel_range Q,
+              std::random_access_iterator O,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires batch_searchable<H, Q, O, Comp, Proj>
+    std::ranges::in_out_result<std::ranges::borrowed_iterator_t<Q>, O>
+    operator()(executor& exec,
+               H&& haystack,
+               Q&& queries,
+               O out,
+               Comp comp = {},
+               Proj proj = {}) const
+    {
+        const auto first = std::ranges::begin(queries);
+        const auto n = range_size(queries);
+        parallel_chunks(
+            exec, n, [&](std::size_t, std::size_t begin, std::size_t end) {
+                batch_lower_bound{}(
+                    haystack,
+                    std::ranges::subrange(advanced(first, begin),
+                                          advanced(first, end)),
+                    advanced(out, begin),
+                    comp,
+                    proj);
+            });
+        return { advanced(first, n), advanced(out, n) };
+    }
+};
+
+// Adds prepare_back to the algorithm F, that binds what prepare returns
+// for the bound arguments, when prepare accepts them.
+template <typename F, typename Prepare>
+struct with_preparation : F {
+    [[no_unique_address]] Prepare prepare;
+
+    template <typename... As>
+    constexpr auto prepare_back(std::tuple<As...>&& as) const
+        -> decltype(prepare(std::move(as)))
+    {
+        return prepare(std::move(as));
+    }
+};
+
+template <typename T>
+concept byte_like = sizeof(T) == 1
+                 && ((std::integral<T> && !std::same_as<T, bool>)
+                     || std::same_as<T, std::byte>);
+
+// A bound argument, which is a range of bytes, after unwrap.
+template <typename A>
+concept byte_pattern
+    = std::ranges::contiguous_range<decltype(unwrap(std::declval<const A&>()))>
+   && std::ranges::sized_range<decltype(unwrap(std::declval<const A&>()))>
+   && byte_like<std::ranges::range_value_t<
+          decltype(unwrap(std::declval<const A&>()))>>;
+
+template <typename T>
+constexpr std::size_t byte_index(T t)
+{
+    return static_cast<unsigned char>(t);
+}
+
+// A haystack that a prepared pattern of A can search.
+template <typename R, typename A>
+concept byte_haystack
+    = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+   && std::same_as<std::ranges::range_value_t<R>,
+                   std::ranges::range_value_t<
+                       decltype(unwrap(std::declval<const A&>()))>>;
+
+// A bound needle A, with the Boyer-Moore-Horspool table of how far the
+// window can move, given its last byte, or its first byte when searching
+// backwards from the end. It is a range of the bytes of the needle, so that
+// the std::ranges algorithms can use it as the needle too.
+//
+// The shifts are bytes, so that copying a bound predicate copies 256 bytes
+// rather than 2 KB. Shifts of needles longer than 255 bytes are cut to 255,
+// which only makes the search take shorter steps.
+template <typename A, bool Backwards>
+class horspool_pattern {
+public:
+    constexpr explicit horspool_pattern(A a) : a_(std::move(a))
+    {
+        const auto m = size();
+        shift_.fill(clamped(m));
+        if constexpr (Backwards) {
+            for (std::size_t i = m; i-- > 1;) {
+                shift_[byte_index(begin()[i])] = clamped(i);
+            }
+        } else {
+            for (std::size_t i = 0; i + 1 < m; ++i) {
+                shift_[byte_index(begin()[i])] = clamped(m - 1 - i);
+            }
+        }
+    }
+
+    constexpr auto begin() const { return std::ranges::begin(unwrap(a_)); }
+
+    constexpr auto end() const { return std::ranges::end(unwrap(a_)); }
+
+    constexpr std::size_t size() const
+    {
+        return static_cast<std::size_t>(std::ranges::size(unwrap(a_)));
+    }
+
+    // Returns the position of the first, or last when Backwards, occurrence
+    // of the needle in the n bytes from first, or n if there is none.
+    template <typename I>
+    constexpr std::size_t find(I first, std::size_t n) const
+    {
+        const auto m = size();
+        if (m > n) {
+            return n;
+        }
+        const auto matches = [&](std::size_t i) {
+            return std::ranges::equal(
+                advanced(first, i), advanced(first, i + m), begin(), end());
+        };
+        if constexpr (Backwards) {
+            for (std::size_t i = n - m;;) {
+                if (matches(i)) {
+                    return i;
+                }
+                const std::size_t step = shift_[byte_index(first[i])];
+                if (step > i) {
+                    return n;
+                }
+                i -= step;
+            }
+        } else {
+            for (std::size_t i = 0; i + m <= n;) {
+                if (matches(i)) {
+                    return i;
+                }
+                i += shift_[byte_index(first[i + m - 1])];
+            }
+            return n;
+        }
+    }
+
+private:
+    static constexpr std::uint8_t clamped(std::size_t shift)
+    {
+        return static_cast<std::uint8_t>(std::min<std::size_t>(shift, 255));
+    }
+
+    A a_;
+    std::array<std::uint8_t, 256> shift_{};
+};
+
+template <bool Backwards>
+struct prepare_horspool {
+    template <byte_pattern A>
+    constexpr std::tuple<horspool_pattern<A, Backwards>>
+    operator()(std::tuple<A>&& as) const
+    {
+        return { horspool_pattern<A, Backwards>(std::get<0>(std::move(as))) };
+    }
+};
+
+struct horspool_search {
+    template <typename R, typename A>
+        requires byte_haystack<R, A>
+    constexpr std::ranges::borrowed_subrange_t<R>
+    operator()(R&& r, const horspool_pattern<A, false>& pattern) const
+    {
+        const auto first = std::ranges::begin(r);
+        const auto n = static_cast<std::size_t>(std::ranges::size(r));
+        const auto i = pattern.size() == 0 ? 0 : pattern.find(first, n);
+        const auto found = advanced(first, i);
+        return { found, i == n ? found : advanced(found, pattern.size()) };
+    }
+};
+
+struct horspool_contains_subrange {
+    template <typename R, typename A>
+        requires byte_haystack<R, A>
+    constexpr bool operator()(R&& r,
+                              const horspool_pattern<A, false>& pattern) const
+    {
+        const auto n = static_cast<std::size_t>(std::ranges::size(r));
+        return pattern.size() == 0
+            || pattern.find(std::ranges::begin(r), n) != n;
+    }
+};
+
+struct horspool_find_end {
+    template <typename R, typename A>
+        requires byte_haystack<R, A>
+    constexpr std::ranges::borrowed_subrange_t<R>
+    operator()(R&& r, const horspool_pattern<A, true>& pattern) const
+    {
+        const auto first = std::ranges::begin(r);
+        const auto n = static_cast<std::size_t>(std::ranges::size(r));
+        const auto i = pattern.size() == 0 ? n : pattern.find(first, n);
+        const auto found = advanced(first, i);
+        return { found, i == n ? found : advanced(found, pattern.size()) };
+    }
+};
+
+// A bound set of bytes A, with a bit per byte value that says whether it is
+// in the set. Like horspool_pattern, it is a range of the bytes of A.
+template <typename A>
+class byte_set {
+public:
+    constexpr explicit byte_set(A a) : a_(std::move(a))
+    {
+        for (const auto b : unwrap(a_)) {
+            const auto i = byte_index(b);
+            bits_[i / 64] |= std::uint64_t{ 1 } << (i % 64);
+        }
+    }
+
+    constexpr auto begin() const { return std::ranges::begin(unwrap(a_)); }
+
+    constexpr auto end() const { return std::ranges::end(unwrap(a_)); }
+
+    template <typename T>
+    constexpr bool contains(T t) const
+    {
+        const auto i = byte_index(t);
+        return (bits_[i / 64] >> (i % 64)) & 1;
+    }
+
+private:
+    A a_;
+    std::array<std::uint64_t, 4> bits_{};
+};
+
+struct prepare_byte_set {
+    template <byte_pattern A>
+    constexpr std::tuple<byte_set<A>> operator()(std::tuple<A>&& as) const
+    {
+        return { byte_set<A>(std::get<0>(std::move(as))) };
+    }
+};
+
+struct byte_set_find_first_of {
+    template <typename R, typename A>
+        requires byte_haystack<R, A>
+    constexpr std::ranges::borrowed_iterator_t<R>
+    operator()(R&& r, const byte_set<A>& set) const
+    {
+        return std::ranges::find_if(
+            r, [&](const auto& b) { return set.contains(b); });
+    }
+};
+
+struct no_parallel_algorithm {};
+
+// Adds overloads to the serial algorithm F, that take an execution policy
+// either first, like the standard library algorithms, or right after the
+// range, which is where it ends up when bound with the other arguments, as
+// in values | sort(par, less). Parallel is called instead of F when it
+// accepts the arguments and use_parallel says so.
+template <typename F, typename Parallel>
+struct with_execution_policy : F {
+    [[no_unique_address]] Parallel parallel;
+
+    using F::operator();
+
+    template <execution_policy P, typename R, typename... Ts>
+    constexpr auto operator()(const P& policy, R&& r, Ts&&... ts) const
+        -> decltype(std::declval<const F&>()(std::forward<R>(r),
+                                             std::forward<Ts>(ts)...))
+    {
+        if constexpr (!std::same_as<P, sequenced_policy>
+                      && requires(executor& exec) {
+                             parallel(exec,
+                                      std::forward<R>(r),
+                                      std::forward<Ts>(ts)...);
+                         }) {
+            if !consteval {
+                if (use_parallel(policy, r)) {
+                    return parallel(policy_executor(policy),
+                                    std::forward<R>(r),
+                                    std::forward<Ts>(ts)...);
+                }
+            }
+        }
+        return F::operator()(std::forward<R>(r), std::forward<Ts>(ts)...);
+    }
+
+    template <typename R, execution_policy P, typename... Ts>
+        requires(!execution_policy<R>)
+    constexpr auto operator()(R&& r, const P& policy, Ts&&... ts) const
+        -> decltype(std::declval<const F&>()(std::forward<R>(r),
+                                             std::forward<Ts>(ts)...))
+    {
+        return (*this)(policy, std::forward<R>(r), std::forward<Ts>(ts)...);
+    }
+};
+
+template <typename F, typename Parallel = no_parallel_algorithm>
+constexpr auto make_algorithm(F&& f, Parallel parallel = {})
+    -> back_binding<with_execution_policy<std::remove_cvref_t<F>, Parallel>>
+{
+    return make_composable_function<back_binding>(
+        with_execution_policy<std::remove_cvref_t<F>, Parallel>{
+            std::forward<F>(f), parallel });
+}
+
+} // namespace internal
+
+inline constexpr auto all_of = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::all_of(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::all_of(std::forward<Ts>(ts)...);
-    } });
+        return internal::vectorized_or<internal::vectorized_all_of>(
+            std::ranges::all_of, std::forward<Ts>(ts)...);
+    } },
+    internal::parallel_all_of{});
 
-inline constexpr auto any_of = make_composable_function<back_binding>(
+inline constexpr auto any_of = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::any_of(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::any_of(std::forward<Ts>(ts)...);
-    } });
+        return internal::vectorized_or<internal::vectorized_any_of>(
+            std::ranges::any_of, std::forward<Ts>(ts)...);
+    } },
+    internal::parallel_any_of{});
 
-inline constexpr auto none_of = make_composable_function<back_binding>(
+inline constexpr auto none_of = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::none_of(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::none_of(std::forward<Ts>(ts)...);
-    } });
+        return internal::vectorized_or<internal::vectorized_none_of>(
+            std::ranges::none_of, std::forward<Ts>(ts)...);
+    } },
+    internal::parallel_none_of{});
 
-inline constexpr auto for_each = make_composable_function<back_binding>(
+inline constexpr auto for_each = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::for_each(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::for_each(std::forward<Ts>(ts)...);
-    });
+    },
+    internal::parallel_for_each{});
 
-inline constexpr auto for_each_n = make_composable_function<back_binding>(
+inline constexpr auto for_each_n = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::for_each_n(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::for_each_n(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto count = make_composable_function<back_binding>(
+inline constexpr auto count = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::count(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::count(std::forward<Ts>(ts)...);
-    } });
+        return internal::vectorized_or<internal::vectorized_count>(
+            std::ranges::count, std::forward<Ts>(ts)...);
+    } },
+    internal::parallel_count{});
 
-inline constexpr auto count_if = make_composable_function<back_binding>(
+inline constexpr auto count_if = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::count_if(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::count_if(std::forward<Ts>(ts)...);
-    } });
+        return internal::vectorized_or<internal::vectorized_count_if>(
+            std::ranges::count_if, std::forward<Ts>(ts)...);
+    } },
+    internal::parallel_count_if{});
 
-inline constexpr auto find = make_composable_function<back_binding>(
+inline constexpr auto find = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::find(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::find(std::forward<Ts>(ts)...);
-    } });
+        return internal::vectorized_or<internal::vectorized_find>(
+            std::ranges::find, std::forward<Ts>(ts)...);
+    } },
+    internal::parallel_find{});
 
-inline constexpr auto find_if = make_composable_function<back_binding>(
+inline constexpr auto find_if = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::find_if(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::find_if(std::forward<Ts>(ts)...);
-    } });
+        return internal::vectorized_or<internal::vectorized_find_if>(
+            std::ranges::find_if, std::forward<Ts>(ts)...);
+    } },
+    internal::parallel_find_if{});
 
 inline constexpr auto find_if_not
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::find_if_not(
                                            std::forward<Ts>(ts)...)) {
-            return std::ranges::find_if_not(std::forward<Ts>(ts)...);
-        } });
+            return internal::vectorized_or<internal::vectorized_find_if_not>(
+                std::ranges::find_if_not, std::forward<Ts>(ts)...);
+        } },
+    internal::parallel_find_if_not{});
 
 inline constexpr auto find_last
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::find_last(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::find_last(std::forward<Ts>(ts)...);
         } });
 
 inline constexpr auto find_last_if
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::find_last_if(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::find_last_if(std::forward<Ts>(ts)...);
         } });
 
-inline constexpr auto find_last_if_not = make_composable_function<back_binding>(
+inline constexpr auto find_last_if_not = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts)
                    -> decltype(std::ranges::find_last_if_not(
                        std::forward<Ts>(ts)...)) {
         return std::ranges::find_last_if_not(std::forward<Ts>(ts)...);
     } });
 
-inline constexpr auto find_end = make_composable_function<back_binding>(
-    nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::find_end(
-                                                  std::forward<Ts>(ts)...)) {
-        return std::ranges::find_end(std::forward<Ts>(ts)...);
-    } });
+inline constexpr auto find_end = internal::make_algorithm(
+    nodiscard{ internal::with_preparation{
+        []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::find_end(
+                                           std::forward<Ts>(ts)...)) {
+            return internal::specialized_or<internal::horspool_find_end>(
+                std::ranges::find_end, std::forward<Ts>(ts)...);
+        },
+        internal::prepare_horspool<true>{} } });
 
 inline constexpr auto find_first_of
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{ internal::with_preparation{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::find_first_of(
                                            std::forward<Ts>(ts)...)) {
-            return std::ranges::find_first_of(std::forward<Ts>(ts)...);
-        } });
+            return internal::specialized_or<internal::byte_set_find_first_of>(
+                std::ranges::find_first_of, std::forward<Ts>(ts)...);
+        },
+        internal::prepare_byte_set{} } });
 
 inline constexpr auto adjacent_find
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::adjacent_find(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::adjacent_find(std::forward<Ts>(ts)...);
         } });
 
-inline constexpr auto search = make_composable_function<back_binding>(
-    nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::search(
-                                                  std::forward<Ts>(ts)...)) {
-        return std::ranges::search(std::forward<Ts>(ts)...);
-    } });
+inline constexpr auto search = internal::make_algorithm(
+    nodiscard{ internal::with_preparation{
+        []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::search(
+                                           std::forward<Ts>(ts)...)) {
+            return internal::specialized_or<internal::horspool_search>(
+                std::ranges::search, std::forward<Ts>(ts)...);
+        },
+        internal::prepare_horspool<false>{} } });
 
-inline constexpr auto search_n = make_composable_function<back_binding>(
+inline constexpr auto search_n = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::search_n(
                                                   std::forward<Ts>(ts)...)) {
         return std::ranges::search_n(std::forward<Ts>(ts)...);
     } });
 
-inline constexpr auto contains = make_composable_function<back_binding>(
+inline constexpr auto contains = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::contains(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::contains(std::forward<Ts>(ts)...);
-    } });
+        return internal::vectorized_or<internal::vectorized_contains>(
+            std::ranges::contains, std::forward<Ts>(ts)...);
+    } },
+    internal::parallel_contains{});
 
 inline constexpr auto contains_subrange
-    = make_composable_function<back_binding>(
-        nodiscard{ []<typename... Ts>(Ts&&... ts)
-                       -> decltype(std::ranges::contains_subrange(
-                           std::forward<Ts>(ts)...)) {
-            return std::ranges::contains_subrange(std::forward<Ts>(ts)...);
-        } });
+    = internal::make_algorithm(nodiscard{ internal::with_preparation{
+        []<typename... Ts>(Ts&&... ts)
+            -> decltype(std::ranges::contains_subrange(
+                std::forward<Ts>(ts)...)) {
+            return internal::specialized_or<
+                internal::horspool_contains_subrange>(
+                std::ranges::contains_subrange, std::forward<Ts>(ts)...);
+        },
+        internal::prepare_horspool<false>{} } });
 
 #if defined(__cpp_lib_ranges_starts_ends_with)
 
 inline constexpr auto starts_with
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::starts_with(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::starts_with(std::forward<Ts>(ts)...);
         } });
 
 inline constexpr auto ends_with
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::ends_with(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::ends_with(std::forward<Ts>(ts)...);
@@ -153,166 +1957,184 @@ inline constexpr auto ends_with
 
 #endif
 
-inline constexpr auto fill = make_composable_function<back_binding>(
+inline constexpr auto fill = internal::make_algorithm(
     []<typename... Ts>(
         Ts&&... ts) -> decltype(std::ranges::fill(std::forward<Ts>(ts)...)) {
         return std::ranges::fill(std::forward<Ts>(ts)...);
-    });
+    },
+    internal::parallel_fill{});
 
-inline constexpr auto fill_n = make_composable_function<back_binding>(
+inline constexpr auto fill_n = internal::make_algorithm(
     []<typename... Ts>(
         Ts&&... ts) -> decltype(std::ranges::fill_n(std::forward<Ts>(ts)...)) {
         return std::ranges::fill_n(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto generate = make_composable_function<back_binding>(
+inline constexpr auto generate = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::generate(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::generate(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto generate_n = make_composable_function<back_binding>(
+inline constexpr auto generate_n = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::generate_n(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::generate_n(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto remove = make_composable_function<back_binding>(
+inline constexpr auto remove = internal::make_algorithm(
     []<typename... Ts>(
         Ts&&... ts) -> decltype(std::ranges::remove(std::forward<Ts>(ts)...)) {
         return std::ranges::remove(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto remove_if = make_composable_function<back_binding>(
+inline constexpr auto remove_if = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::remove_if(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::remove_if(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto replace = make_composable_function<back_binding>(
+inline constexpr auto replace = internal::make_algorithm(
     []<typename... Ts>(
         Ts&&... ts) -> decltype(std::ranges::replace(std::forward<Ts>(ts)...)) {
         return std::ranges::replace(std::forward<Ts>(ts)...);
-    });
+    },
+    internal::parallel_replace{});
 
-inline constexpr auto replace_if = make_composable_function<back_binding>(
+inline constexpr auto replace_if = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::replace_if(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::replace_if(std::forward<Ts>(ts)...);
-    });
+    },
+    internal::parallel_replace_if{});
 
-inline constexpr auto unique = make_composable_function<back_binding>(
+inline constexpr auto unique = internal::make_algorithm(
     []<typename... Ts>(
         Ts&&... ts) -> decltype(std::ranges::unique(std::forward<Ts>(ts)...)) {
         return std::ranges::unique(std::forward<Ts>(ts)...);
     });
 
 inline constexpr auto is_partitioned
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::is_partitioned(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::is_partitioned(std::forward<Ts>(ts)...);
         } });
 
-inline constexpr auto partition = make_composable_function<back_binding>(
+inline constexpr auto partition = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::partition(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::partition(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto partition_copy = make_composable_function<back_binding>(
+inline constexpr auto partition_copy = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::partition_copy(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::partition_copy(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto stable_partition = make_composable_function<back_binding>(
+inline constexpr auto stable_partition = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::stable_partition(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::stable_partition(std::forward<Ts>(ts)...);
     });
 
 inline constexpr auto partition_point
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::partition_point(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::partition_point(std::forward<Ts>(ts)...);
         } });
 
 inline constexpr auto is_sorted
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::is_sorted(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::is_sorted(std::forward<Ts>(ts)...);
         } });
 
 inline constexpr auto is_sorted_until
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::is_sorted_until(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::is_sorted_until(std::forward<Ts>(ts)...);
         } });
 
 inline constexpr auto lower_bound
-    = make_composable_function<back_binding>(nodiscard{
-        []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::lower_bound(
-                                           std::forward<Ts>(ts)...)) {
-            return std::ranges::lower_bound(std::forward<Ts>(ts)...);
+    = internal::make_algorithm(nodiscard{
+        []<typename... Ts>(Ts&&... ts)
+            -> decltype(internal::specialized_or<internal::index_lower_bound>(
+                std::ranges::lower_bound, std::forward<Ts>(ts)...)) {
+            return internal::specialized_or<internal::index_lower_bound>(
+                std::ranges::lower_bound, std::forward<Ts>(ts)...);
         } });
 
 inline constexpr auto upper_bound
-    = make_composable_function<back_binding>(nodiscard{
-        []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::upper_bound(
-                                           std::forward<Ts>(ts)...)) {
-            return std::ranges::upper_bound(std::forward<Ts>(ts)...);
+    = internal::make_algorithm(nodiscard{
+        []<typename... Ts>(Ts&&... ts)
+            -> decltype(internal::specialized_or<internal::index_upper_bound>(
+                std::ranges::upper_bound, std::forward<Ts>(ts)...)) {
+            return internal::specialized_or<internal::index_upper_bound>(
+                std::ranges::upper_bound, std::forward<Ts>(ts)...);
         } });
 
 inline constexpr auto binary_search
-    = make_composable_function<back_binding>(nodiscard{
-        []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::binary_search(
-                                           std::forward<Ts>(ts)...)) {
-            return std::ranges::binary_search(std::forward<Ts>(ts)...);
+    = internal::make_algorithm(nodiscard{
+        []<typename... Ts>(Ts&&... ts)
+            -> decltype(internal::specialized_or<internal::index_binary_search>(
+                std::ranges::binary_search, std::forward<Ts>(ts)...)) {
+            return internal::specialized_or<internal::index_binary_search>(
+                std::ranges::binary_search, std::forward<Ts>(ts)...);
         } });
 
 inline constexpr auto equal_range
-    = make_composable_function<back_binding>(nodiscard{
-        []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::equal_range(
-                                           std::forward<Ts>(ts)...)) {
-            return std::ranges::equal_range(std::forward<Ts>(ts)...);
+    = internal::make_algorithm(nodiscard{
+        []<typename... Ts>(Ts&&... ts)
+            -> decltype(internal::specialized_or<internal::index_equal_range>(
+                std::ranges::equal_range, std::forward<Ts>(ts)...)) {
+            return internal::specialized_or<internal::index_equal_range>(
+                std::ranges::equal_range, std::forward<Ts>(ts)...);
         } });
 
-inline constexpr auto merge = make_composable_function<back_binding>(
+inline constexpr auto lower_bound_batch = internal::make_algorithm(
+    internal::batch_lower_bound{}, internal::parallel_batch_lower_bound{});
+
+inline constexpr auto merge = internal::make_algorithm(
     []<typename... Ts>(
         Ts&&... ts) -> decltype(std::ranges::merge(std::forward<Ts>(ts)...)) {
-        return std::ranges::merge(std::forward<Ts>(ts)...);
+        return internal::specialized_or<internal::galloping_merge>(
+            std::ranges::merge, std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto inplace_merge = make_composable_function<back_binding>(
+inline constexpr auto inplace_merge = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::inplace_merge(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::inplace_merge(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto includes = make_composable_function<back_binding>(
+inline constexpr auto includes = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::includes(
                                                   std::forward<Ts>(ts)...)) {
-        return std::ranges::includes(std::forward<Ts>(ts)...);
+        return internal::specialized_or<internal::galloping_includes>(
+            std::ranges::includes, std::forward<Ts>(ts)...);
     } });
 
-inline constexpr auto set_difference = make_composable_function<back_binding>(
+inline constexpr auto set_difference = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::set_difference(
                                        std::forward<Ts>(ts)...)) {
-        return std::ranges::set_difference(std::forward<Ts>(ts)...);
+        return internal::specialized_or<internal::galloping_set_difference>(
+            std::ranges::set_difference, std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto set_intersection = make_composable_function<back_binding>(
+inline constexpr auto set_intersection = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::set_intersection(
                                        std::forward<Ts>(ts)...)) {
-        return std::ranges::set_intersection(std::forward<Ts>(ts)...);
+        return internal::specialized_or<internal::galloping_set_intersection>(
+            std::ranges::set_intersection, std::forward<Ts>(ts)...);
     });
 
 inline constexpr auto set_symmetric_difference
-    = make_composable_function<back_binding>(
+    = internal::make_algorithm(
         []<typename... Ts>(Ts&&... ts)
             -> decltype(std::ranges::set_symmetric_difference(
                 std::forward<Ts>(ts)...)) {
@@ -320,119 +2142,155 @@ inline constexpr auto set_symmetric_difference
                 std::forward<Ts>(ts)...);
         });
 
-inline constexpr auto set_union = make_composable_function<back_binding>(
+inline constexpr auto set_union = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::set_union(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::set_union(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto is_heap = make_composable_function<back_binding>(
+inline constexpr auto is_heap = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::is_heap(
                                                   std::forward<Ts>(ts)...)) {
         return std::ranges::is_heap(std::forward<Ts>(ts)...);
     } });
 
 inline constexpr auto is_heap_until
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::is_heap_until(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::is_heap_until(std::forward<Ts>(ts)...);
         } });
 
-inline constexpr auto make_heap = make_composable_function<back_binding>(
+inline constexpr auto make_heap = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::make_heap(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::make_heap(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto push_heap = make_composable_function<back_binding>(
+inline constexpr auto push_heap = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::push_heap(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::push_heap(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto pop_heap = make_composable_function<back_binding>(
+inline constexpr auto pop_heap = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::pop_heap(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::pop_heap(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto sort_heap = make_composable_function<back_binding>(
+inline constexpr auto sort_heap = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::sort_heap(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::sort_heap(std::forward<Ts>(ts)...);
     });
 
-inline constexpr auto max = make_composable_function<back_binding>(
+inline constexpr auto max = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::max(
                                                   std::forward<Ts>(ts)...)) {
         return std::ranges::max(std::forward<Ts>(ts)...);
     } });
 
 inline constexpr auto max_element
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::max_element(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::max_element(std::forward<Ts>(ts)...);
-        } });
+        } },
+    internal::parallel_max_element{});
 
-inline constexpr auto min = make_composable_function<back_binding>(
+inline constexpr auto min = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::min(
                                                   std::forward<Ts>(ts)...)) {
         return std::ranges::min(std::forward<Ts>(ts)...);
     } });
 
 inline constexpr auto min_element
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::min_element(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::min_element(std::forward<Ts>(ts)...);
-        } });
+        } },
+    internal::parallel_min_element{});
 
 inline constexpr auto minmax_element
-    = make_composable_function<back_binding>(nodiscard{
+    = internal::make_algorithm(nodiscard{
         []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::minmax_element(
                                            std::forward<Ts>(ts)...)) {
             return std::ranges::minmax_element(std::forward<Ts>(ts)...);
-        } });
+        } },
+    internal::parallel_minmax_element{});
 
-inline constexpr auto clamp = make_composable_function<back_binding>(
+inline constexpr auto clamp = internal::make_algorithm(
     nodiscard{ []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::clamp(
                                                   std::forward<Ts>(ts)...)) {
         return std::ranges::clamp(std::forward<Ts>(ts)...);
     } });
 
-inline constexpr auto sort = make_composable_function<back_binding>(
+inline constexpr auto sort = internal::make_algorithm(
     []<typename... Ts>(
         Ts&&... ts) -> decltype(std::ranges::sort(std::forward<Ts>(ts)...)) {
-        return std::ranges::sort(std::forward<Ts>(ts)...);
-    });
+        return internal::vectorized_or<internal::radix_sorter<false>>(
+            std::ranges::sort, std::forward<Ts>(ts)...);
+    },
+    internal::parallel_sort<false>{});
 
-inline constexpr auto partial_sort = make_composable_function<back_binding>(
+inline constexpr auto partial_sort = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::partial_sort(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::partial_sort(std::forward<Ts>(ts)...);
     });
 
 inline constexpr auto partial_sort_copy
-    = make_composable_function<back_binding>(
+    = internal::make_algorithm(
         []<typename... Ts>(Ts&&... ts)
             -> decltype(std::ranges::partial_sort_copy(
                 std::forward<Ts>(ts)...)) {
             return std::ranges::partial_sort_copy(std::forward<Ts>(ts)...);
         });
 
-inline constexpr auto stable_sort = make_composable_function<back_binding>(
+inline constexpr auto stable_sort = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::stable_sort(
                                        std::forward<Ts>(ts)...)) {
-        return std::ranges::stable_sort(std::forward<Ts>(ts)...);
-    });
+        return internal::vectorized_or<internal::radix_sorter<true>>(
+            std::ranges::stable_sort, std::forward<Ts>(ts)...);
+    },
+    internal::parallel_sort<true>{});
 
-inline constexpr auto nth_element = make_composable_function<back_binding>(
+inline constexpr auto nth_element = internal::make_algorithm(
     []<typename... Ts>(Ts&&... ts) -> decltype(std::ranges::nth_element(
                                        std::forward<Ts>(ts)...)) {
         return std::ranges::nth_element(std::forward<Ts>(ts)...);
-    });
+    },
+    internal::parallel_nth_element{});
+
+inline constexpr auto top_k = internal::make_algorithm(
+    nodiscard{ internal::bounded_top_k{} }, internal::parallel_top_k{});
+
+inline constexpr auto radix_sort
+    = internal::make_algorithm(internal::radix_sorter<true, 0>{});
+
+inline constexpr auto sort_by_key
+    = internal::make_algorithm(internal::key_cached_sort<false>{});
+
+inline constexpr auto stable_sort_by_key
+    = internal::make_algorithm(internal::key_cached_sort<true>{});
+
+inline constexpr auto is_sorted_until_by_key = internal::make_algorithm(
+    nodiscard{ internal::key_cached_is_sorted_until{} });
+
+inline constexpr auto is_sorted_by_key = internal::make_algorithm(
+    nodiscard{ []<typename R, typename... Ts>(R&& r, Ts&&... ts)
+                   -> decltype(internal::key_cached_is_sorted_until{}(
+                                   r, std::forward<Ts>(ts)...),
+                               true) {
+        return internal::key_cached_is_sorted_until{}(
+                   r, std::forward<Ts>(ts)...)
+            == std::ranges::end(r);
+    } });
+
+inline constexpr auto adjacent_find_by_key = internal::make_algorithm(
+    nodiscard{ internal::key_cached_adjacent_find{} });
 } // namespace composer
 
 #endif // COMPOSER_ALGORITHM_HPP
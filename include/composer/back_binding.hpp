@@ -57,12 +57,17 @@ struct [[nodiscard]] back_binding : composable_function<F> {
     operator()(this Self&& self,
                Ts&&... ts) -> back_binding<decltype(internal::back_binder{
         std::forward<Self>(self),
-        std::tuple<internal::arg_binder_t<Ts>...>(std::forward<Ts>(ts)...) })>
+        internal::prepare_back(self.f,
+                                std::tuple<internal::arg_binder_t<Ts>...>(
+                                    std::forward<Ts>(ts)...)) })>
         requires(!requires {
             std::forward_like<Self>(self.f)(std::forward<Ts>(ts)...);
         })
     {
-        return { std::forward<Self>(self), { std::forward<Ts>(ts)... } };
+        auto as = internal::prepare_back(
+            self.f,
+            std::tuple<internal::arg_binder_t<Ts>...>(std::forward<Ts>(ts)...));
+        return { std::forward<Self>(self), std::move(as) };
     }
 };
 
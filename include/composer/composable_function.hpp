@@ -2,6 +2,7 @@
 #define COMPOSER_COMPOSABLE_FUNCTION_HPP
 
 #include <ranges>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -92,6 +93,32 @@ struct not_dangling<C<Ts...>> {};
 template <typename T>
 using not_dangling_t = typename not_dangling<T>::type;
 
+// Returns the tuple of arguments to bind to the function object f. f can
+// compute once, when arguments are bound to it, what it would otherwise
+// compute from them on every call, by having a member function
+// prepare_back(as), or prepare_front(as) for front binding, that takes the
+// tuple of arguments and returns the tuple to bind instead, e.g. a pattern
+// with its search tables.
+template <typename F, typename... As>
+constexpr auto prepare_back(const F& f, std::tuple<As...>&& as)
+{
+    if constexpr (requires { f.prepare_back(std::move(as)); }) {
+        return f.prepare_back(std::move(as));
+    } else {
+        return std::move(as);
+    }
+}
+
+template <typename F, typename... As>
+constexpr auto prepare_front(const F& f, std::tuple<As...>&& as)
+{
+    if constexpr (requires { f.prepare_front(std::move(as)); }) {
+        return f.prepare_front(std::move(as));
+    } else {
+        return std::move(as);
+    }
+}
+
 } // namespace internal
 
 template <typename T, std::size_t N>
@@ -110,23 +137,144 @@ template <typename T, std::size_t N>
 constexpr auto unwrap(const internal::buffer<T, N>&& t) -> const T (&)[N]
     = delete;
 
+template <typename F>
+struct composable_function;
+
 namespace internal {
-template <typename LH, typename RH>
-struct composition {
-    LH lh;
-    RH rh;
-    static constexpr bool is_nodiscard = nodiscard_function<RH>;
+// The result of a stage of a pipeline, as the stage returned it, i.e. a
+// reference or a value, which ->* passes on to the next stage.
+template <typename T>
+struct stage_result {
+    T value;
+
+    template <typename F>
+    constexpr auto operator->*(F&& f) &&
+        -> stage_result<decltype(std::forward<F>(f)(std::forward<T>(value)))>
+    {
+        return { std::forward<F>(f)(std::forward<T>(value)) };
+    }
+
+    constexpr T&& get() && { return std::forward<T>(value); }
+};
+
+template <typename Self, typename... Ts>
+constexpr auto first_stage(Self&& self, Ts&&... ts) -> stage_result<
+    decltype(std::forward_like<Self>(std::get<0>(self.fs))(
+        std::forward<Ts>(ts)...))>
+{
+    return { std::forward_like<Self>(std::get<0>(self.fs))(
+        std::forward<Ts>(ts)...) };
+}
+
+// Calls the stages one after the other from here, folding ->* over the
+// stages between the first and the last, instead of each stage calling the
+// next, so that the calls do not nest deeper with more stages. The last
+// stage is called directly, so that its result is returned as is.
+template <typename Self, std::size_t... Is, typename... Ts>
+constexpr auto call_stages(Self&& self, std::index_sequence<Is...>, Ts&&... ts)
+    -> decltype(std::forward_like<Self>(std::get<sizeof...(Is) + 1>(self.fs))(
+        (first_stage(std::forward<Self>(self), std::forward<Ts>(ts)...)
+         ->* ...
+         ->* std::forward_like<Self>(std::get<Is + 1>(self.fs)))
+            .get()))
+{
+    return std::forward_like<Self>(std::get<sizeof...(Is) + 1>(self.fs))(
+        (first_stage(std::forward<Self>(self), std::forward<Ts>(ts)...)
+         ->* ...
+         ->* std::forward_like<Self>(std::get<Is + 1>(self.fs)))
+            .get());
+}
+
+template <typename... Fs>
+struct pipeline {
+    static constexpr bool is_nodiscard = nodiscard_function<
+        std::tuple_element_t<sizeof...(Fs) - 1, std::tuple<Fs...>>>;
+    [[no_unique_address]] std::tuple<Fs...> fs;
 
     template <typename Self, typename... Ts>
     [[nodiscard]] constexpr auto operator()(this Self&& self, Ts&&... ts)
-        -> decltype(std::forward_like<Self>(self.rh)(
-            std::forward_like<Self>(self.lh)(std::forward<Ts>(ts)...)))
+        -> decltype(call_stages(std::forward<Self>(self),
+                                std::make_index_sequence<sizeof...(Fs) - 2>{},
+                                std::forward<Ts>(ts)...))
     {
-        return std::forward_like<Self>(self.rh)(
-            std::forward_like<Self>(self.lh)(std::forward<Ts>(ts)...));
+        return call_stages(std::forward<Self>(self),
+                           std::make_index_sequence<sizeof...(Fs) - 2>{},
+                           std::forward<Ts>(ts)...);
     }
 };
 
+// Predicate introspection splits pipelines into shorter ones, which can have
+// a single stage.
+template <typename F>
+struct pipeline<F> {
+    static constexpr bool is_nodiscard = nodiscard_function<F>;
+    [[no_unique_address]] std::tuple<F> fs;
+
+    template <typename Self, typename... Ts>
+    [[nodiscard]] constexpr auto operator()(this Self&& self, Ts&&... ts)
+        -> decltype(std::forward_like<Self>(std::get<0>(self.fs))(
+            std::forward<Ts>(ts)...))
+    {
+        return std::forward_like<Self>(std::get<0>(self.fs))(
+            std::forward<Ts>(ts)...);
+    }
+};
+
+template <typename F>
+struct pipeline_stages {
+    using type = std::tuple<F>;
+
+    template <typename T>
+    static constexpr type get(T&& t)
+    {
+        return type(std::forward<T>(t));
+    }
+};
+
+template <typename... Fs>
+struct pipeline_stages<pipeline<Fs...>> {
+    using type = std::tuple<Fs...>;
+
+    template <typename T>
+    static constexpr type get(T&& t)
+    {
+        return std::forward_like<T>(t.fs);
+    }
+};
+
+template <typename... Fs>
+struct pipeline_stages<composable_function<pipeline<Fs...>>> {
+    using type = std::tuple<Fs...>;
+
+    template <typename T>
+    static constexpr type get(T&& t)
+    {
+        return std::forward_like<T>(t.f.fs);
+    }
+};
+
+template <typename, typename>
+struct join_pipeline;
+
+template <typename... LHs, typename... RHs>
+struct join_pipeline<std::tuple<LHs...>, std::tuple<RHs...>> {
+    using type = pipeline<LHs..., RHs...>;
+};
+
+template <typename LH, typename RH>
+using join_pipeline_t =
+    typename join_pipeline<typename pipeline_stages<LH>::type,
+                           typename pipeline_stages<RH>::type>::type;
+
+template <typename LH, typename RH>
+constexpr auto make_pipeline(LH&& lh, RH&& rh)
+    -> join_pipeline_t<std::remove_cvref_t<LH>, std::remove_cvref_t<RH>>
+{
+    return { std::tuple_cat(
+        pipeline_stages<std::remove_cvref_t<LH>>::get(std::forward<LH>(lh)),
+        pipeline_stages<std::remove_cvref_t<RH>>::get(std::forward<RH>(rh))) };
+}
+
 template <typename, typename>
 struct rebind_function;
 
@@ -166,9 +314,10 @@ struct [[nodiscard]] composable_function {
     [[nodiscard]] constexpr auto operator|(this Self&& self, RH&& rh)
         -> internal::rebind_function_t<
             std::remove_cvref_t<Self>,
-            internal::composition<F, std::remove_cvref_t<RH>>>
+            internal::join_pipeline_t<F, std::remove_cvref_t<RH>>>
     {
-        return { { std::forward_like<Self>(self.f), std::forward<RH>(rh) } };
+        return { { internal::make_pipeline(std::forward_like<Self>(self.f),
+                                           std::forward<RH>(rh)) } };
     }
 };
 
@@ -0,0 +1,121 @@
+#ifndef COMPOSER_EXECUTION_HPP
+#define COMPOSER_EXECUTION_HPP
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <ranges>
+#include <type_traits>
+
+namespace composer {
+
+struct sequenced_policy {};
+
+struct parallel_policy {
+    // ranges with fewer elements than this are processed on the calling
+    // thread, since handing work to other threads costs more than it gains.
+    std::size_t threshold = std::size_t{ 1 } << 16;
+    // nullptr means default_executor()
+    executor* pool = nullptr;
+};
+
+struct parallel_unsequenced_policy {
+    std::size_t threshold = std::size_t{ 1 } << 16;
+    executor* pool = nullptr;
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+template <typename T>
+concept execution_policy
+    = std::same_as<std::remove_cvref_t<T>, sequenced_policy>
+   || std::same_as<std::remove_cvref_t<T>, parallel_policy>
+   || std::same_as<std::remove_cvref_t<T>, parallel_unsequenced_policy>;
+
+namespace internal {
+
+template <typename R>
+concept parallel_range
+    = std::ranges::random_access_range<R> && std::ranges::sized_range<R>;
+
+template <typename P, typename R>
+constexpr bool use_parallel(const P& policy, R& r)
+{
+    if constexpr (!parallel_range<R>) {
+        return false;
+    } else {
+        const auto size = static_cast<std::size_t>(std::ranges::size(r));
+        return size > 1 && size >= policy.threshold;
+    }
+}
+
+template <typename P>
+executor& policy_executor(const P& policy)
+{
+    return policy.pool ? *policy.pool : default_executor();
+}
+
+// There are more chunks than threads, so that threads that finish early can
+// steal chunks from the others.
+inline std::size_t parallel_chunk_count(const executor& exec, std::size_t n)
+{
+    return std::clamp<std::size_t>(
+        4 * (exec.concurrency() + 1), 1, std::max<std::size_t>(n, 1));
+}
+
+// Splits [0, n) into parallel_chunk_count(exec, n) consecutive non-empty
+// chunks, and calls f(chunk, first, last) for each of them. The calling
+// thread takes the first chunk, the others are submitted to exec, and the
+// calling thread runs tasks from exec until they are all done. If any call
+// throws, the first exception caught is rethrown when all chunks are done.
+template <typename F>
+void parallel_chunks(executor& exec, std::size_t n, const F& f)
+{
+    const auto chunks = parallel_chunk_count(exec, n);
+    const auto size = n / chunks;
+    const auto rest = n % chunks;
+    std::exception_ptr error;
+    std::mutex mutex;
+    const auto run = [&](std::size_t chunk) {
+        const auto first = chunk * size + std::min(chunk, rest);
+        const auto last = first + size + (chunk < rest ? 1 : 0);
+        try {
+            f(chunk, first, last);
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+    std::latch done(static_cast<std::ptrdiff_t>(chunks - 1));
+    for (std::size_t chunk = 1; chunk != chunks; ++chunk) {
+        exec.submit([&run, &done, chunk] {
+            run(chunk);
+            done.count_down();
+        });
+    }
+    run(0);
+    while (!done.try_wait()) {
+        // When there is nothing left to run, the remaining chunks are
+        // running on other threads.
+        if (!exec.try_run_one()) {
+            done.wait();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace internal
+} // namespace composer
+
+#endif // COMPOSER_EXECUTION_HPP
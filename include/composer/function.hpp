@@ -0,0 +1,218 @@
+#ifndef COMPOSER_FUNCTION_HPP
+#define COMPOSER_FUNCTION_HPP
+
+#include "composable_function.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace composer {
+
+namespace internal {
+
+inline constexpr std::size_t default_function_buffer_size
+    = 4 * sizeof(void*);
+
+// Invocability is checked first, so that probing with types that are not
+// callables, like the bases of std::tuple, never asks if they are copyable.
+template <typename F, typename R, typename... Args>
+concept erasable
+    = std::is_invocable_r_v<R, F&, Args...> && std::copy_constructible<F>;
+
+template <typename Sig, std::size_t Size>
+class erased_function;
+
+template <typename R, typename... Args, std::size_t Size>
+class erased_function<R(Args...), Size> {
+    static_assert(Size >= sizeof(void*),
+                  "the buffer must at least hold a pointer");
+
+public:
+    static constexpr bool is_nodiscard = !std::is_void_v<R>;
+
+    template <typename F>
+    static constexpr bool stores_inline
+        = sizeof(F) <= Size && alignof(F) <= alignof(std::max_align_t)
+       && std::is_nothrow_move_constructible_v<F>;
+
+    template <typename F>
+    static constexpr bool accepts = erasable<F, R, Args...>;
+
+    erased_function() = default;
+
+    template <typename F, typename... Ts>
+    explicit erased_function(std::in_place_type_t<F>, Ts&&... ts)
+    {
+        target<F>::create(buffer_, std::forward<Ts>(ts)...);
+        vtable_ = &vtable_for<F>;
+    }
+
+    erased_function(const erased_function& other)
+    {
+        if (other.vtable_) {
+            other.vtable_->copy(other.buffer_, buffer_);
+            vtable_ = other.vtable_;
+        }
+    }
+
+    erased_function(erased_function&& other) noexcept
+    {
+        if (other.vtable_) {
+            other.vtable_->move(other.buffer_, buffer_);
+            vtable_ = std::exchange(other.vtable_, nullptr);
+        }
+    }
+
+    ~erased_function() { reset(); }
+
+    erased_function& operator=(const erased_function& other)
+    {
+        if (this != &other) {
+            erased_function copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    erased_function& operator=(erased_function&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            if (other.vtable_) {
+                other.vtable_->move(other.buffer_, buffer_);
+                vtable_ = std::exchange(other.vtable_, nullptr);
+            }
+        }
+        return *this;
+    }
+
+    explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+    R operator()(Args... args) const
+    {
+        if (!vtable_) {
+            throw std::bad_function_call();
+        }
+        return vtable_->call(buffer_, std::forward<Args>(args)...);
+    }
+
+private:
+    struct vtable {
+        R (*call)(void*, Args&&...);
+        void (*copy)(const void*, void*);
+        void (*move)(void*, void*) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template <typename F>
+    struct target {
+        static F& get(void* p) noexcept
+        {
+            if constexpr (stores_inline<F>) {
+                return *std::launder(static_cast<F*>(p));
+            } else {
+                return **static_cast<F**>(p);
+            }
+        }
+
+        template <typename... Ts>
+        static void create(void* p, Ts&&... ts)
+        {
+            if constexpr (stores_inline<F>) {
+                ::new (p) F(std::forward<Ts>(ts)...);
+            } else {
+                ::new (p) F*(new F(std::forward<Ts>(ts)...));
+            }
+        }
+
+        static R call(void* p, Args&&... args)
+        {
+            return std::invoke_r<R>(get(p), std::forward<Args>(args)...);
+        }
+
+        static void copy(const void* from, void* to)
+        {
+            create(to, std::as_const(get(const_cast<void*>(from))));
+        }
+
+        static void move(void* from, void* to) noexcept
+        {
+            if constexpr (stores_inline<F>) {
+                ::new (to) F(std::move(get(from)));
+                get(from).~F();
+            } else {
+                ::new (to) F*(*static_cast<F**>(from));
+            }
+        }
+
+        static void destroy(void* p) noexcept
+        {
+            if constexpr (stores_inline<F>) {
+                get(p).~F();
+            } else {
+                delete *static_cast<F**>(p);
+            }
+        }
+    };
+
+    template <typename F>
+    static constexpr vtable vtable_for{ &target<F>::call,
+                                        &target<F>::copy,
+                                        &target<F>::move,
+                                        &target<F>::destroy };
+
+    void reset() noexcept
+    {
+        if (vtable_) {
+            std::exchange(vtable_, nullptr)->destroy(buffer_);
+        }
+    }
+
+    alignas(std::max_align_t) mutable std::byte buffer_[Size];
+    const vtable* vtable_ = nullptr;
+};
+} // namespace internal
+
+template <typename Sig,
+          std::size_t BufferSize = internal::default_function_buffer_size>
+struct [[nodiscard]] function
+    : composable_function<internal::erased_function<Sig, BufferSize>> {
+    using erased = internal::erased_function<Sig, BufferSize>;
+
+    template <typename F>
+    static constexpr bool stores_inline
+        = erased::template stores_inline<std::decay_t<F>>;
+
+    function() = default;
+
+    function(std::nullptr_t) noexcept {}
+
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, function>
+                 && erased::template accepts<std::decay_t<F>>)
+    function(F&& f)
+        : composable_function<erased>{
+            erased(std::in_place_type<std::decay_t<F>>, std::forward<F>(f))
+        }
+    {}
+
+    explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(this->f);
+    }
+};
+
+namespace internal {
+template <typename Sig, std::size_t BufferSize, typename FF>
+struct rebind_function<function<Sig, BufferSize>, FF> {
+    using type = composable_function<FF>;
+};
+} // namespace internal
+
+} // namespace composer
+
+#endif // COMPOSER_FUNCTION_HPP
@@ -0,0 +1,110 @@
+#ifndef COMPOSER_FUNCTION_REF_HPP
+#define COMPOSER_FUNCTION_REF_HPP
+
+#include "composable_function.hpp"
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace composer {
+
+namespace internal {
+
+template <typename Sig>
+class function_reference;
+
+template <typename R, typename... Args>
+class function_reference<R(Args...)> {
+public:
+    static constexpr bool is_nodiscard = !std::is_void_v<R>;
+
+    template <typename F>
+    static constexpr bool accepts
+        = !std::is_member_pointer_v<std::remove_cvref_t<F>>
+       && std::is_invocable_r_v<R, std::remove_reference_t<F>&, Args...>;
+
+    template <typename F>
+        requires std::is_function_v<F>
+    explicit function_reference(F* f) noexcept
+        : target_{ .function = reinterpret_cast<void (*)()>(f) }
+        , call_(&call_function<F>)
+    {}
+
+    template <typename F>
+        requires(!std::is_function_v<F>)
+    explicit function_reference(F& f) noexcept
+        : target_{ .object = const_cast<void*>(
+                       static_cast<const void*>(std::addressof(f))) }
+        , call_(&call_object<F>)
+    {}
+
+    R operator()(Args... args) const
+    {
+        return call_(target_, std::forward<Args>(args)...);
+    }
+
+private:
+    union target {
+        void* object;
+        void (*function)();
+    };
+
+    template <typename F>
+    static R call_object(target t, Args&&... args)
+    {
+        return std::invoke_r<R>(*static_cast<F*>(t.object),
+                                std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static R call_function(target t, Args&&... args)
+    {
+        return std::invoke_r<R>(reinterpret_cast<F*>(t.function),
+                                std::forward<Args>(args)...);
+    }
+
+    target target_;
+    R (*call_)(target, Args&&...);
+};
+} // namespace internal
+
+template <typename Sig>
+struct [[nodiscard]] function_ref
+    : composable_function<internal::function_reference<Sig>> {
+    using reference = internal::function_reference<Sig>;
+
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, function_ref>
+                 && reference::template accepts<F>)
+    function_ref(F&& f) noexcept
+        : composable_function<reference>{ make(f) }
+    {}
+
+private:
+    template <typename F>
+    static reference make(F& f) noexcept
+    {
+        if constexpr (std::is_pointer_v<std::remove_cv_t<F>>
+                      && std::is_function_v<
+                          std::remove_pointer_t<std::remove_cv_t<F>>>) {
+            return reference(f);
+        } else if constexpr (std::is_function_v<F>) {
+            return reference(&f);
+        } else {
+            return reference(f);
+        }
+    }
+};
+
+namespace internal {
+template <typename Sig, typename FF>
+struct rebind_function<function_ref<Sig>, FF> {
+    using type = composable_function<FF>;
+};
+} // namespace internal
+
+} // namespace composer
+
+#endif // COMPOSER_FUNCTION_REF_HPP
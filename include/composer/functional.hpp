@@ -3,7 +3,12 @@
 
 #include "back_binding.hpp"
 
+#include <concepts>
+#include <cstddef>
 #include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace composer {
 
@@ -112,14 +117,129 @@ COMPOSER_MAKE_OP(rh, >>);
 
 #undef COMPOSER_MAKE_OP
 
+namespace internal {
+
+// All of fs are called, and the results are combined with & or |, so that
+// there is no branch on the result of one before the next is called. This
+// costs more calls than && and || but has no branches to mispredict, and
+// allows loops over the data to be vectorized.
+template <typename Combine, typename... Fs>
+struct branchless_combination {
+    static constexpr auto indexes = std::index_sequence_for<Fs...>{};
+    [[no_unique_address]] std::tuple<Fs...> fs;
+
+    template <typename Self, typename... Ts>
+    constexpr auto operator()(this Self&& self, const Ts&... ts)
+        -> decltype(std::forward<Self>(self).call(indexes, ts...))
+    {
+        return std::forward<Self>(self).call(indexes, ts...);
+    }
+
+    template <typename Self, std::size_t... Is, typename... Ts>
+    constexpr auto call(this Self&& self, std::index_sequence<Is...>,
+                        const Ts&... ts)
+        -> decltype(Combine{}(static_cast<bool>(
+            std::forward_like<Self>(std::get<Is>(self.fs))(ts...))...))
+    {
+        return Combine{}(static_cast<bool>(
+            std::forward_like<Self>(std::get<Is>(self.fs))(ts...))...);
+    }
+};
+
+struct bit_and_all {
+    template <std::same_as<bool>... Bs>
+    constexpr bool operator()(Bs... bs) const
+    {
+        return (bs & ...);
+    }
+};
+
+struct bit_or_all {
+    template <std::same_as<bool>... Bs>
+    constexpr bool operator()(Bs... bs) const
+    {
+        return (bs | ...);
+    }
+};
+
+template <typename... Fs>
+using branchless_and = branchless_combination<bit_and_all, Fs...>;
+
+template <typename... Fs>
+using branchless_or = branchless_combination<bit_or_all, Fs...>;
+
+// Both alternatives are called, and the result is chosen from the values, a
+// choice that compilers make with a conditional move or a blend rather than a
+// branch.
+template <typename C, typename A, typename B>
+struct branchless_select {
+    C cond;
+    A a;
+    B b;
+
+    template <typename Self, typename... Ts>
+    constexpr auto operator()(this Self&& self, const Ts&... ts)
+        -> std::common_type_t<
+            decltype(std::forward_like<Self>(self.a)(ts...)),
+            decltype(std::forward_like<Self>(self.b)(ts...))>
+        requires requires {
+            static_cast<bool>(std::forward_like<Self>(self.cond)(ts...));
+        }
+    {
+        using result = std::common_type_t<
+            decltype(std::forward_like<Self>(self.a)(ts...)),
+            decltype(std::forward_like<Self>(self.b)(ts...))>;
+        const bool c
+            = static_cast<bool>(std::forward_like<Self>(self.cond)(ts...));
+        result av = std::forward_like<Self>(self.a)(ts...);
+        result bv = std::forward_like<Self>(self.b)(ts...);
+        return c ? av : bv;
+    }
+};
+} // namespace internal
+
+// Like fs && ..., but all of fs are called.
+template <composable_function_type... Fs>
+    requires(sizeof...(Fs) > 0)
+constexpr auto all(Fs&&... fs)
+{
+    return make_composable_function(nodiscard{
+        internal::branchless_and<std::remove_cvref_t<Fs>...>{
+            { std::forward<Fs>(fs)... } } });
+}
+
+// Like fs || ..., but all of fs are called.
+template <composable_function_type... Fs>
+    requires(sizeof...(Fs) > 0)
+constexpr auto any(Fs&&... fs)
+{
+    return make_composable_function(nodiscard{
+        internal::branchless_or<std::remove_cvref_t<Fs>...>{
+            { std::forward<Fs>(fs)... } } });
+}
+
+// select(cond, a, b)(ts...) is cond(ts...) ? a(ts...) : b(ts...), but both a
+// and b are called.
+template <composable_function_type C,
+          composable_function_type A,
+          composable_function_type B>
+constexpr auto select(C&& cond, A&& a, B&& b)
+{
+    return make_composable_function(nodiscard{ internal::branchless_select{
+        std::forward<C>(cond), std::forward<A>(a), std::forward<B>(b) } });
+}
+
+// The return types are deduced, so that the constraints reject other types,
+// like iterators with composer types as template arguments, before anything
+// else is looked at.
 template <composable_function_type F>
-constexpr auto operator!(F&& f) -> decltype(std::forward<F>(f) | logical_not)
+constexpr auto operator!(F&& f)
 {
     return std::forward<F>(f) | logical_not;
 }
 
 template <composable_function_type F>
-constexpr auto operator*(F&& f) -> decltype(std::forward<F>(f) | dereference)
+constexpr auto operator*(F&& f)
 {
     return std::forward<F>(f) | dereference;
 }
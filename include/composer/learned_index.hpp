@@ -0,0 +1,234 @@
+#ifndef COMPOSER_LEARNED_INDEX_HPP
+#define COMPOSER_LEARNED_INDEX_HPP
+
+#include "predicate.hpp"
+#include "search_index.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace composer {
+namespace internal {
+
+// Comparisons that order numbers like <, for which the position of a key
+// can be predicted from its value.
+template <typename Comp>
+concept ascending_comparison
+    = comparison_kind<predicate_core_t<Comp>> == predicate_kind::less;
+
+} // namespace internal
+
+// A model of where the keys of a sorted random access range, projected with
+// proj, are, made of line segments from key to position, each of them
+// within epsilon positions of the first position of every distinct key it
+// covers. A search finds the segment of the value, and searches the range
+// around the predicted position, so keys that are evenly spread out, e.g.
+// ids or timestamps, are found in a few steps, whatever the size of the
+// range. The window is widened exponentially when the answer is outside,
+// so the results are correct for any sorted range, only slower for ranges
+// whose keys are clustered.
+//
+// Like a search_index, a learned_index is a range of the elements of the
+// indexed range, and composer::lower_bound, upper_bound, binary_search and
+// equal_range search it through the model, when they are called without a
+// projection and with std::ranges::less or composer::less_than. The keys
+// must be numbers, sorted in ascending order. The model must be rebuilt
+// when the keys in the range change.
+template <std::ranges::random_access_range R, typename Proj = std::identity>
+    requires std::ranges::sized_range<R>
+          && std::is_arithmetic_v<std::remove_cvref_t<
+              std::indirect_result_t<Proj&, std::ranges::iterator_t<R>>>>
+class learned_index {
+public:
+    using iterator = std::ranges::iterator_t<R>;
+    using key_type = std::remove_cvref_t<
+        std::indirect_result_t<Proj&, std::ranges::iterator_t<R>>>;
+
+    explicit learned_index(R& r, Proj proj = {}, std::size_t epsilon = 32)
+        : first_(std::ranges::begin(r)),
+          size_(static_cast<std::size_t>(std::ranges::size(r))),
+          epsilon_(std::max<std::size_t>(epsilon, 1)),
+          proj_(std::move(proj))
+    {
+        build();
+    }
+
+    iterator begin() const { return first_; }
+
+    iterator end() const { return first_ + diff(size_); }
+
+    std::size_t size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    // The number of line segments in the model.
+    std::size_t segments() const noexcept { return segments_.size(); }
+
+    // The first element whose key is not less than value.
+    template <typename T, typename Comp = std::ranges::less>
+        requires std::is_arithmetic_v<T>
+              && internal::ascending_comparison<Comp>
+    iterator lower_bound(const T& value, Comp comp = {}) const
+    {
+        return first_ + diff(search(value, [&](const key_type& key) {
+                   return std::invoke(comp, key, value);
+               }));
+    }
+
+    // The first element whose key is greater than value.
+    template <typename T, typename Comp = std::ranges::less>
+        requires std::is_arithmetic_v<T>
+              && internal::ascending_comparison<Comp>
+    iterator upper_bound(const T& value, Comp comp = {}) const
+    {
+        return first_ + diff(search(value, [&](const key_type& key) {
+                   return !std::invoke(comp, value, key);
+               }));
+    }
+
+    template <typename T, typename Comp = std::ranges::less>
+        requires std::is_arithmetic_v<T>
+              && internal::ascending_comparison<Comp>
+    bool contains(const T& value, Comp comp = {}) const
+    {
+        const auto found = lower_bound(value, comp);
+        return found != end() && !std::invoke(comp, value, key(found));
+    }
+
+private:
+    // Predicts position + slope * (key - first_key) for keys from
+    // first_key.
+    struct segment {
+        key_type first_key;
+        double position;
+        double slope;
+    };
+
+    static constexpr auto diff(std::size_t n)
+    {
+        return static_cast<std::iter_difference_t<iterator>>(n);
+    }
+
+    key_type key(iterator it) const { return std::invoke(proj_, *it); }
+
+    key_type key_at(std::size_t i) const { return key(first_ + diff(i)); }
+
+    // Makes the segments in one pass over the distinct keys. The slopes
+    // that keep all keys of the current segment within epsilon of their
+    // positions make a cone, that narrows with every key, and a new segment
+    // starts when a key leaves it empty.
+    void build()
+    {
+        constexpr double infinity = std::numeric_limits<double>::infinity();
+        const auto eps = static_cast<double>(epsilon_);
+        double low = -infinity;
+        double high = infinity;
+        const auto close = [&] {
+            auto& last = segments_.back();
+            last.slope = low == -infinity ? 0.0 : (low + high) / 2;
+        };
+        for (std::size_t i = 0; i != size_; ++i) {
+            const key_type k = key_at(i);
+            if (i != 0 && !(key_at(i - 1) < k)) {
+                continue;
+            }
+            if (!segments_.empty()) {
+                const auto& last = segments_.back();
+                const double dx = static_cast<double>(k)
+                                - static_cast<double>(last.first_key);
+                const double dy = static_cast<double>(i) - last.position;
+                const double lo = (dy - eps) / dx;
+                const double hi = (dy + eps) / dx;
+                if (lo <= high && hi >= low) {
+                    low = std::max(low, lo);
+                    high = std::min(high, hi);
+                    continue;
+                }
+                close();
+            }
+            segments_.push_back({ k, static_cast<double>(i), 0.0 });
+            low = -infinity;
+            high = infinity;
+        }
+        if (!segments_.empty()) {
+            close();
+        }
+    }
+
+    template <typename T>
+    std::size_t predict(const T& value) const
+    {
+        auto s = std::ranges::upper_bound(
+            segments_, value, std::ranges::less{}, &segment::first_key);
+        if (s != segments_.begin()) {
+            --s;
+        }
+        const double position
+            = s->position
+            + s->slope
+                  * (static_cast<double>(value)
+                     - static_cast<double>(s->first_key));
+        if (!(position > 0)) {
+            return 0;
+        }
+        return position < static_cast<double>(size_)
+                 ? static_cast<std::size_t>(position)
+                 : size_;
+    }
+
+    // Returns the first position whose key is not before value, searching
+    // epsilon positions around the predicted position, and further out,
+    // doubling the distance, while the answer is outside.
+    template <typename T, typename Before>
+    std::size_t search(const T& value, Before before) const
+    {
+        if (size_ == 0) {
+            return 0;
+        }
+        const std::size_t guess = predict(value);
+        std::size_t lo = guess - std::min(guess, epsilon_);
+        std::size_t hi = std::min(size_, guess + epsilon_);
+        for (std::size_t step = epsilon_; lo != 0 && !before(key_at(lo - 1));
+             step *= 2) {
+            hi = lo;
+            lo -= std::min(lo, step);
+        }
+        for (std::size_t step = epsilon_; hi != size_ && before(key_at(hi));
+             step *= 2) {
+            lo = hi + 1;
+            hi = std::min(size_, hi + step);
+        }
+        while (lo != hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (before(key_at(mid))) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    iterator first_;
+    std::size_t size_;
+    std::size_t epsilon_;
+    [[no_unique_address]] Proj proj_;
+    std::vector<segment> segments_;
+};
+
+namespace internal {
+
+template <typename R, typename Proj>
+inline constexpr bool is_search_index<learned_index<R, Proj>> = true;
+
+} // namespace internal
+} // namespace composer
+
+#endif // COMPOSER_LEARNED_INDEX_HPP
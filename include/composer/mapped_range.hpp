@@ -0,0 +1,215 @@
+#ifndef COMPOSER_MAPPED_RANGE_HPP
+#define COMPOSER_MAPPED_RANGE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <ranges>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace composer {
+
+// How the elements of a mapped_range will be accessed, passed on to the
+// kernel with madvise, so that it can read ahead, or not, and keep pages.
+enum class access_advice { normal, sequential, random, willneed, hugepages };
+
+enum class map_mode { read_only, read_write };
+
+namespace internal {
+
+[[noreturn]] inline void throw_errno(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Closes the file when it goes out of scope. A mapping stays valid after
+// its file is closed.
+struct file_descriptor {
+    int fd;
+
+    explicit file_descriptor(int d) : fd(d) {}
+
+    file_descriptor(const file_descriptor&) = delete;
+    file_descriptor& operator=(const file_descriptor&) = delete;
+
+    ~file_descriptor()
+    {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+inline int madvise_advice(access_advice advice) noexcept
+{
+    switch (advice) {
+    case access_advice::sequential:
+        return MADV_SEQUENTIAL;
+    case access_advice::random:
+        return MADV_RANDOM;
+    case access_advice::willneed:
+        return MADV_WILLNEED;
+    case access_advice::hugepages:
+#if defined(MADV_HUGEPAGE)
+        return MADV_HUGEPAGE;
+#else
+        return MADV_NORMAL;
+#endif
+    case access_advice::normal:
+        break;
+    }
+    return MADV_NORMAL;
+}
+
+} // namespace internal
+
+// A file of fixed size records of type T, mapped into memory as a contiguous
+// range of T, so that algorithms run directly over the page cache, without
+// reading the file into a copy. With map_mode::read_write the elements can
+// be changed, and the changes are written to the file.
+template <typename T, map_mode Mode = map_mode::read_only>
+    requires std::is_trivially_copyable_v<T>
+class mapped_range
+    : public std::ranges::view_interface<mapped_range<T, Mode>> {
+public:
+    using value_type = T;
+    using element_type
+        = std::conditional_t<Mode == map_mode::read_only, const T, T>;
+
+    mapped_range() = default;
+
+    // Maps the whole file at path. Bytes after the last whole T are not
+    // part of the range.
+    explicit mapped_range(const std::filesystem::path& path,
+                          access_advice advice = access_advice::normal)
+    {
+        const internal::file_descriptor file{ ::open(
+            path.c_str(),
+            Mode == map_mode::read_only ? O_RDONLY : O_RDWR) };
+        if (file.fd < 0) {
+            internal::throw_errno("open");
+        }
+        struct stat status;
+        if (::fstat(file.fd, &status) != 0) {
+            internal::throw_errno("fstat");
+        }
+        map(file.fd, static_cast<std::size_t>(status.st_size) / sizeof(T));
+        advise(advice);
+    }
+
+    // Creates the file at path if it does not exist, resizes it to count
+    // elements, and maps it. New elements are zero bytes.
+    mapped_range(const std::filesystem::path& path,
+                 std::size_t count,
+                 access_advice advice = access_advice::normal)
+        requires(Mode == map_mode::read_write)
+    {
+        const internal::file_descriptor file{ ::open(
+            path.c_str(), O_RDWR | O_CREAT, 0666) };
+        if (file.fd < 0) {
+            internal::throw_errno("open");
+        }
+        if (::ftruncate(file.fd, static_cast<off_t>(count * sizeof(T)))
+            != 0) {
+            internal::throw_errno("ftruncate");
+        }
+        map(file.fd, count);
+        advise(advice);
+    }
+
+    mapped_range(mapped_range&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    mapped_range& operator=(mapped_range&& other) noexcept
+    {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_range() { unmap(); }
+
+    element_type* begin() const noexcept { return data_; }
+
+    element_type* end() const noexcept { return data_ + size_; }
+
+    element_type* data() const noexcept { return data_; }
+
+    std::size_t size() const noexcept { return size_; }
+
+    // Tells the kernel how the elements will be accessed from now on. This
+    // is only a hint, so failures are ignored, e.g. hugepages for a file
+    // system that does not support them.
+    void advise(access_advice advice) const noexcept
+    {
+        if (size_ != 0) {
+            ::madvise(address(), bytes(), internal::madvise_advice(advice));
+        }
+    }
+
+    // Writes the changed elements to the file, and waits until they are
+    // written. They are written eventually anyway, also without flush.
+    void flush() const
+        requires(Mode == map_mode::read_write)
+    {
+        if (size_ != 0 && ::msync(address(), bytes(), MS_SYNC) != 0) {
+            internal::throw_errno("msync");
+        }
+    }
+
+private:
+    // An empty file cannot be mapped, so an empty range maps nothing.
+    void map(int fd, std::size_t count)
+    {
+        if (count == 0) {
+            return;
+        }
+        constexpr int protection = Mode == map_mode::read_only
+                                     ? PROT_READ
+                                     : PROT_READ | PROT_WRITE;
+        void* p = ::mmap(
+            nullptr, count * sizeof(T), protection, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            internal::throw_errno("mmap");
+        }
+        data_ = static_cast<element_type*>(p);
+        size_ = count;
+    }
+
+    void unmap() noexcept
+    {
+        if (data_ != nullptr) {
+            ::munmap(address(), bytes());
+        }
+    }
+
+    void* address() const noexcept
+    {
+        return const_cast<std::remove_const_t<element_type>*>(data_);
+    }
+
+    std::size_t bytes() const noexcept { return size_ * sizeof(T); }
+
+    element_type* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace composer
+
+#endif
+
+#endif // COMPOSER_MAPPED_RANGE_HPP
@@ -0,0 +1,371 @@
+#ifndef COMPOSER_MEMOIZE_HPP
+#define COMPOSER_MEMOIZE_HPP
+
+#include "composable_function.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace composer {
+
+namespace internal {
+
+// A cache maps keys to values with find(key), which returns a pointer to the
+// cached value or nullptr, and insert(key, value), for keys that are not
+// cached. Pointers returned are valid until the next call to insert.
+
+template <typename Key, typename Value>
+class flat_hash_table {
+public:
+    template <typename Policy>
+    explicit flat_hash_table(const Policy&)
+    {}
+
+    const Value* find(const Key& key) const
+    {
+        if (slots_.empty()) {
+            return nullptr;
+        }
+        const auto mask = slots_.size() - 1;
+        for (auto i = std::hash<Key>{}(key) & mask;; i = (i + 1) & mask) {
+            const auto slot = slots_[i];
+            if (slot == 0) {
+                return nullptr;
+            }
+            if (entries_[slot - 1].first == key) {
+                return &entries_[slot - 1].second;
+            }
+        }
+    }
+
+    const Value& insert(const Key& key, Value value)
+    {
+        if (2 * (entries_.size() + 1) > slots_.size()) {
+            slots_.assign(std::max<std::size_t>(16, 2 * slots_.size()), 0);
+            for (std::size_t n = 1; n <= entries_.size(); ++n) {
+                place(n);
+            }
+        }
+        entries_.emplace_back(key, std::move(value));
+        place(entries_.size());
+        return entries_.back().second;
+    }
+
+private:
+    void place(std::size_t n)
+    {
+        const auto mask = slots_.size() - 1;
+        auto i = std::hash<Key>{}(entries_[n - 1].first) & mask;
+        while (slots_[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = n;
+    }
+
+    std::vector<std::pair<Key, Value>> entries_;
+    // 0 is an empty slot, n refers to entries_[n - 1]
+    std::vector<std::size_t> slots_;
+};
+
+template <typename Key, typename Value>
+class lru_table {
+public:
+    template <typename Policy>
+    explicit lru_table(const Policy& policy)
+        : capacity_(std::max<std::size_t>(1, policy.capacity))
+    {}
+
+    const Value* find(const Key& key)
+    {
+        const auto i = index_.find(key);
+        if (i == index_.end()) {
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, i->second);
+        return &i->second->second;
+    }
+
+    const Value& insert(const Key& key, Value value)
+    {
+        if (entries_.size() == capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.emplace_front(key, std::move(value));
+        index_.emplace(key, entries_.begin());
+        return entries_.front().second;
+    }
+
+private:
+    using entry_list = std::list<std::pair<Key, Value>>;
+
+    std::size_t capacity_;
+    // most recently used first
+    entry_list entries_;
+    std::unordered_map<Key, typename entry_list::iterator> index_;
+};
+
+template <typename Key, typename Value>
+class direct_mapped_table {
+public:
+    template <typename Policy>
+    explicit direct_mapped_table(const Policy& policy)
+        : slots_(std::bit_ceil(std::max<std::size_t>(1, policy.slots)))
+    {}
+
+    const Value* find(const Key& key) const
+    {
+        const auto& slot = slots_[index(key)];
+        if (slot && slot->first == key) {
+            return &slot->second;
+        }
+        return nullptr;
+    }
+
+    const Value& insert(const Key& key, Value value)
+    {
+        auto& slot = slots_[index(key)];
+        slot.emplace(key, std::move(value));
+        return slot->second;
+    }
+
+private:
+    std::size_t index(const Key& key) const
+    {
+        return std::hash<Key>{}(key) & (slots_.size() - 1);
+    }
+
+    std::vector<std::optional<std::pair<Key, Value>>> slots_;
+};
+
+template <typename Cache, typename Key, typename Miss>
+auto cached_value(Cache& cache, const Key& key, Miss&& miss)
+{
+    using value_type = std::remove_cvref_t<decltype(*cache.find(key))>;
+    if (const auto* p = cache.find(key)) {
+        return value_type(*p);
+    }
+    return value_type(cache.insert(key, std::forward<Miss>(miss)()));
+}
+
+template <typename Inner>
+class sharded_table {
+public:
+    template <typename Policy>
+    explicit sharded_table(const Policy& policy)
+        : shift_(64 - std::countr_zero(shard_count(policy.shards)))
+    {
+        for (auto n = shard_count(policy.shards); n != 0; --n) {
+            shards_.emplace_back(policy.policy);
+        }
+    }
+
+    // miss is called without holding a lock, so concurrent misses for the
+    // same key may call it more than once, but only one result is cached.
+    template <typename Key, typename Miss>
+    auto get(const Key& key, Miss&& miss)
+    {
+        auto& s = shard_for(key);
+        {
+            std::lock_guard lock(s.mutex);
+            if (const auto* p = s.cache.find(key)) {
+                return std::remove_cvref_t<decltype(*p)>(*p);
+            }
+        }
+        auto value = std::forward<Miss>(miss)();
+        std::lock_guard lock(s.mutex);
+        return cached_value(s.cache, key,
+                            [&value] { return std::move(value); });
+    }
+
+private:
+    struct shard {
+        template <typename Policy>
+        explicit shard(const Policy& policy)
+            : cache(policy)
+        {}
+
+        std::mutex mutex;
+        Inner cache;
+    };
+
+    static std::size_t shard_count(std::size_t n)
+    {
+        return std::bit_ceil(std::clamp<std::size_t>(n, 1, 1024));
+    }
+
+    template <typename Key>
+    shard& shard_for(const Key& key)
+    {
+        // The inner caches index on the low bits of the hash, so the shard
+        // is selected by the high bits of a multiplicative hash.
+        if (shards_.size() == 1) {
+            return shards_.front();
+        }
+        const std::uint64_t h = std::hash<Key>{}(key);
+        return shards_[static_cast<std::size_t>((h * 0x9e3779b97f4a7c15U)
+                                                >> shift_)];
+    }
+
+    int shift_;
+    std::deque<shard> shards_;
+};
+
+template <typename Cache>
+struct cache_access {
+    template <typename Key, typename Miss>
+    static auto get(Cache& cache, const Key& key, Miss&& miss)
+    {
+        return cached_value(cache, key, std::forward<Miss>(miss));
+    }
+};
+
+template <typename Inner>
+struct cache_access<sharded_table<Inner>> {
+    template <typename Key, typename Miss>
+    static auto get(sharded_table<Inner>& cache, const Key& key, Miss&& miss)
+    {
+        return cache.get(key, std::forward<Miss>(miss));
+    }
+};
+
+template <typename F>
+struct unary_argument {};
+
+template <typename F>
+    requires requires { &F::operator(); }
+struct unary_argument<F> : unary_argument<decltype(&F::operator())> {};
+
+template <typename F>
+struct unary_argument<composable_function<F>> : unary_argument<F> {};
+
+template <typename R, typename A>
+struct unary_argument<R (*)(A)> {
+    using type = A;
+};
+
+template <typename R, typename A>
+struct unary_argument<R (*)(A) noexcept> {
+    using type = A;
+};
+
+template <typename R, typename C, typename A>
+struct unary_argument<R (C::*)(A)> {
+    using type = A;
+};
+
+template <typename R, typename C, typename A>
+struct unary_argument<R (C::*)(A) const> {
+    using type = A;
+};
+
+template <typename R, typename C, typename A>
+struct unary_argument<R (C::*)(A) noexcept> {
+    using type = A;
+};
+
+template <typename R, typename C, typename A>
+struct unary_argument<R (C::*)(A) const noexcept> {
+    using type = A;
+};
+
+template <typename Key, typename F>
+struct memo_key {
+    using type = Key;
+};
+
+template <typename F>
+struct memo_key<void, F> {
+    using type = std::remove_cvref_t<
+        typename unary_argument<std::decay_t<F>>::type>;
+};
+
+template <typename F, typename Key, typename Cache>
+struct memoized {
+    static constexpr bool is_nodiscard = true;
+    using value_type = std::decay_t<std::invoke_result_t<const F&, const Key&>>;
+
+    [[no_unique_address]] F f;
+    std::shared_ptr<Cache> cache;
+
+    value_type operator()(const Key& key) const
+    {
+        return cache_access<Cache>::get(*cache, key, [this, &key] {
+            return value_type(std::invoke(f, key));
+        });
+    }
+};
+
+} // namespace internal
+
+struct unbounded_cache {
+    template <typename Key, typename Value>
+    using cache = internal::flat_hash_table<Key, Value>;
+};
+
+struct lru_cache {
+    template <typename Key, typename Value>
+    using cache = internal::lru_table<Key, Value>;
+
+    std::size_t capacity;
+};
+
+struct direct_mapped_cache {
+    template <typename Key, typename Value>
+    using cache = internal::direct_mapped_table<Key, Value>;
+
+    std::size_t slots;
+};
+
+template <typename Policy>
+struct concurrent_cache {
+    template <typename Key, typename Value>
+    using cache = internal::sharded_table<
+        typename Policy::template cache<Key, Value>>;
+
+    Policy policy;
+    std::size_t shards = 16;
+};
+
+template <typename Policy>
+concurrent_cache(Policy) -> concurrent_cache<Policy>;
+
+template <typename Policy>
+concurrent_cache(Policy, std::size_t) -> concurrent_cache<Policy>;
+
+template <typename Key = void,
+          typename F,
+          typename Policy = unbounded_cache,
+          typename K = typename internal::memo_key<Key, F>::type>
+[[nodiscard]] auto memoize(F&& f, const Policy& policy = {})
+    -> composable_function<internal::memoized<
+        std::decay_t<F>,
+        K,
+        typename Policy::template cache<
+            K,
+            std::decay_t<
+                std::invoke_result_t<const std::decay_t<F>&, const K&>>>>>
+    requires std::invocable<const std::decay_t<F>&, const K&>
+{
+    using value_type = std::decay_t<
+        std::invoke_result_t<const std::decay_t<F>&, const K&>>;
+    using cache_type = typename Policy::template cache<K, value_type>;
+    return { { std::forward<F>(f), std::make_shared<cache_type>(policy) } };
+}
+
+} // namespace composer
+
+#endif // COMPOSER_MEMOIZE_HPP
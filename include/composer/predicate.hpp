@@ -0,0 +1,312 @@
+#ifndef COMPOSER_PREDICATE_HPP
+#define COMPOSER_PREDICATE_HPP
+
+#include "functional.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace composer {
+
+// The shape of a predicate built from the composer function objects, so that
+// algorithms can recognize common predicates and use faster implementations
+// for them.
+enum class predicate_kind {
+    opaque,
+    equal_to,
+    not_equal_to,
+    less,
+    less_equal,
+    greater,
+    greater_equal,
+    logical_and,
+    logical_or,
+    logical_not
+};
+
+namespace internal {
+
+template <typename F>
+inline constexpr predicate_kind comparison_kind = predicate_kind::opaque;
+template <>
+inline constexpr predicate_kind comparison_kind<std::ranges::equal_to>
+    = predicate_kind::equal_to;
+template <>
+inline constexpr predicate_kind comparison_kind<std::ranges::not_equal_to>
+    = predicate_kind::not_equal_to;
+template <>
+inline constexpr predicate_kind comparison_kind<std::ranges::less>
+    = predicate_kind::less;
+template <>
+inline constexpr predicate_kind comparison_kind<std::ranges::less_equal>
+    = predicate_kind::less_equal;
+template <>
+inline constexpr predicate_kind comparison_kind<std::ranges::greater>
+    = predicate_kind::greater;
+template <>
+inline constexpr predicate_kind comparison_kind<std::ranges::greater_equal>
+    = predicate_kind::greater_equal;
+
+constexpr bool is_comparison_kind(predicate_kind kind)
+{
+    return kind != predicate_kind::opaque && kind != predicate_kind::logical_and
+        && kind != predicate_kind::logical_or
+        && kind != predicate_kind::logical_not;
+}
+
+// Wrappers that do not change what a function does are looked through, so
+// that e.g. composable_function<nodiscard<op_and<L, R>>> is seen as op_and.
+template <typename T>
+struct predicate_layer {
+    static constexpr const T& core(const T& t) { return t; }
+};
+
+template <typename T>
+using predicate_core_t = std::remove_cvref_t<
+    decltype(predicate_layer<T>::core(std::declval<const T&>()))>;
+
+template <typename F>
+struct predicate_layer<composable_function<F>> {
+    static constexpr auto& core(const composable_function<F>& t)
+    {
+        return predicate_layer<F>::core(t.f);
+    }
+};
+
+template <typename F>
+struct predicate_layer<back_binding<F>> {
+    static constexpr auto& core(const back_binding<F>& t)
+    {
+        return predicate_layer<F>::core(t.f);
+    }
+};
+
+template <typename F>
+struct predicate_layer<nodiscard<F>> {
+    static constexpr auto& core(const nodiscard<F>& t)
+    {
+        return predicate_layer<F>::core(static_cast<const F&>(t));
+    }
+};
+
+template <typename F>
+struct predicate_layer<pipeline<F>> {
+    static constexpr auto& core(const pipeline<F>& t)
+    {
+        return predicate_layer<F>::core(std::get<0>(t.fs));
+    }
+};
+
+template <typename T>
+constexpr auto& predicate_core(const T& t)
+{
+    return predicate_layer<T>::core(t);
+}
+
+template <typename T>
+struct predicate_shape {
+    static constexpr predicate_kind kind = predicate_kind::opaque;
+};
+
+// A comparison with its right hand side bound, e.g. less_than(x).
+template <typename F, typename A>
+    requires(comparison_kind<predicate_core_t<F>> != predicate_kind::opaque)
+struct predicate_shape<back_binder<F, A>> {
+    static constexpr predicate_kind kind = comparison_kind<predicate_core_t<F>>;
+
+    static constexpr auto& operand(const back_binder<F, A>& p)
+    {
+        return unwrap(std::get<0>(p.as));
+    }
+
+    static constexpr std::identity projection(const back_binder<F, A>&)
+    {
+        return {};
+    }
+};
+
+template <typename L, typename R>
+struct predicate_shape<op_and<L, R>> {
+    static constexpr predicate_kind kind = predicate_kind::logical_and;
+    static constexpr std::size_t children = 2;
+
+    template <std::size_t I>
+    static constexpr auto& child(const op_and<L, R>& p)
+    {
+        if constexpr (I == 0) {
+            return p.lhf;
+        } else {
+            return p.rhf;
+        }
+    }
+};
+
+template <typename L, typename R>
+struct predicate_shape<op_or<L, R>> {
+    static constexpr predicate_kind kind = predicate_kind::logical_or;
+    static constexpr std::size_t children = 2;
+
+    template <std::size_t I>
+    static constexpr auto& child(const op_or<L, R>& p)
+    {
+        if constexpr (I == 0) {
+            return p.lhf;
+        } else {
+            return p.rhf;
+        }
+    }
+};
+
+// all(fs...) and any(fs...)
+template <typename Combine, typename... Fs>
+    requires std::same_as<Combine, bit_and_all>
+          || std::same_as<Combine, bit_or_all>
+struct predicate_shape<branchless_combination<Combine, Fs...>> {
+    static constexpr predicate_kind kind
+        = std::same_as<Combine, bit_and_all> ? predicate_kind::logical_and
+                                             : predicate_kind::logical_or;
+    static constexpr std::size_t children = sizeof...(Fs);
+
+    template <std::size_t I>
+    static constexpr auto&
+    child(const branchless_combination<Combine, Fs...>& p)
+    {
+        return std::get<I>(p.fs);
+    }
+};
+
+// proj | comparison is a comparison with a projection, and
+// f | logical_not is the negation of f.
+template <typename... Fs>
+    requires(sizeof...(Fs) > 1)
+struct predicate_shape<pipeline<Fs...>> {
+    static constexpr std::size_t prefix_size = sizeof...(Fs) - 1;
+    using last = std::tuple_element_t<prefix_size, std::tuple<Fs...>>;
+    using last_core = predicate_core_t<last>;
+    using last_shape = predicate_shape<last_core>;
+
+    static constexpr bool is_comparison = is_comparison_kind(last_shape::kind);
+
+    static constexpr bool is_negation
+        = std::same_as<last_core, std::logical_not<>>;
+
+    static constexpr predicate_kind kind
+        = is_comparison ? last_shape::kind
+        : is_negation   ? predicate_kind::logical_not
+                        : predicate_kind::opaque;
+    static constexpr std::size_t children = is_negation ? 1 : 0;
+
+    template <std::size_t... Is>
+    static constexpr auto prefix(const pipeline<Fs...>& p,
+                                 std::index_sequence<Is...>)
+    {
+        using stages = std::tuple<Fs...>;
+        return composable_function<
+            pipeline<std::tuple_element_t<Is, stages>...>>{
+            { { std::get<Is>(p.fs)... } }
+        };
+    }
+
+    static constexpr auto& operand(const pipeline<Fs...>& p)
+        requires is_comparison
+    {
+        return last_shape::operand(
+            predicate_core(std::get<prefix_size>(p.fs)));
+    }
+
+    template <std::size_t... Is>
+    static constexpr bool is_identity(std::index_sequence<Is...>)
+    {
+        using stages = std::tuple<Fs...>;
+        return (std::same_as<
+                    predicate_core_t<std::tuple_element_t<Is, stages>>,
+                    std::identity>
+                && ...);
+    }
+
+    // A prefix of only identity stages is no projection at all.
+    static constexpr auto projection(const pipeline<Fs...>& p)
+        requires is_comparison
+    {
+        if constexpr (is_identity(std::make_index_sequence<prefix_size>{})) {
+            return std::identity{};
+        } else {
+            return prefix(p, std::make_index_sequence<prefix_size>{});
+        }
+    }
+
+    template <std::size_t I>
+    static constexpr auto child(const pipeline<Fs...>& p)
+        requires(is_negation && I == 0)
+    {
+        return prefix(p, std::make_index_sequence<prefix_size>{});
+    }
+};
+
+template <typename P>
+using predicate_shape_t
+    = predicate_shape<predicate_core_t<std::remove_cvref_t<P>>>;
+
+} // namespace internal
+
+template <typename P>
+inline constexpr predicate_kind predicate_kind_v
+    = internal::predicate_shape_t<P>::kind;
+
+// A predicate that compares proj(x) with a bound operand.
+template <typename P>
+concept comparison_predicate
+    = internal::is_comparison_kind(predicate_kind_v<P>);
+
+// A predicate that combines the results of other predicates.
+template <typename P>
+concept logical_predicate = predicate_kind_v<P> != predicate_kind::opaque
+                         && !comparison_predicate<P>;
+
+// The bound right hand side of a comparison, e.g. x in less_than(x).
+template <comparison_predicate P>
+[[nodiscard]] constexpr auto& predicate_operand(const P& p)
+{
+    return internal::predicate_shape_t<P>::operand(
+        internal::predicate_core(p));
+}
+
+// The function applied to the value before it is compared, e.g. mem_fn(&T::x)
+// in &T::x | less_than(x), or std::identity if there is none.
+template <comparison_predicate P>
+[[nodiscard]] constexpr auto predicate_projection(const P& p)
+{
+    return internal::predicate_shape_t<P>::projection(
+        internal::predicate_core(p));
+}
+
+template <comparison_predicate P>
+using predicate_operand_t = std::remove_cvref_t<
+    decltype(predicate_operand(std::declval<const P&>()))>;
+
+template <comparison_predicate P>
+using predicate_projection_t
+    = decltype(predicate_projection(std::declval<const P&>()));
+
+// The number of operands of a logical predicate.
+template <logical_predicate P>
+inline constexpr std::size_t predicate_child_count_v
+    = internal::predicate_shape_t<P>::children;
+
+// The operands of a logical predicate, 0 and 1 for && and ||, one per
+// function for all and any, and 0 for !. The operands of &&, ||, all and any
+// are returned by reference, the operand of ! is returned by value.
+template <std::size_t I, logical_predicate P>
+    requires(I < predicate_child_count_v<P>)
+[[nodiscard]] constexpr decltype(auto) predicate_child(const P& p)
+{
+    return internal::predicate_shape_t<P>::template child<I>(
+        internal::predicate_core(p));
+}
+
+} // namespace composer
+
+#endif // COMPOSER_PREDICATE_HPP
@@ -0,0 +1,215 @@
+#ifndef COMPOSER_RADIX_SORT_HPP
+#define COMPOSER_RADIX_SORT_HPP
+
+#include "predicate.hpp"
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace composer {
+namespace internal {
+
+// Ranges shorter than this are sorted faster by comparisons than by the
+// passes over the whole range that radix sort makes.
+inline constexpr std::size_t radix_sort_threshold = 1024;
+
+template <std::size_t Size>
+struct radix_unsigned {};
+
+template <>
+struct radix_unsigned<1> {
+    using type = std::uint8_t;
+};
+
+template <>
+struct radix_unsigned<2> {
+    using type = std::uint16_t;
+};
+
+template <>
+struct radix_unsigned<4> {
+    using type = std::uint32_t;
+};
+
+template <>
+struct radix_unsigned<8> {
+    using type = std::uint64_t;
+};
+
+template <typename T>
+concept radix_key
+    = ((std::integral<T> && !std::same_as<T, bool>) || std::is_enum_v<T>
+       || std::same_as<T, float> || std::same_as<T, double>)
+   && requires { typename radix_unsigned<sizeof(T)>::type; };
+
+// Encodes keys as unsigned integers, that are in the same order as the keys.
+template <radix_key T>
+struct radix_key_traits {
+    using unsigned_type = typename radix_unsigned<sizeof(T)>::type;
+
+    static constexpr unsigned_type sign_bit = unsigned_type{ 1 }
+                                           << (sizeof(T) * 8 - 1);
+
+    static constexpr unsigned_type encode(T t)
+    {
+        if constexpr (std::is_enum_v<T>) {
+            using underlying = std::underlying_type_t<T>;
+            return radix_key_traits<underlying>::encode(
+                static_cast<underlying>(t));
+        } else if constexpr (std::floating_point<T>) {
+            // -0.0 + 0.0 is 0.0, so that -0.0 and 0.0, which compare equal,
+            // get the same encoding. Negative values have their bits
+            // flipped, since a larger magnitude is a smaller value.
+            const auto bits = std::bit_cast<unsigned_type>(t + T{});
+            return (bits & sign_bit) ? static_cast<unsigned_type>(~bits)
+                                     : static_cast<unsigned_type>(bits
+                                                                  | sign_bit);
+        } else if constexpr (std::is_signed_v<T>) {
+            return static_cast<unsigned_type>(static_cast<unsigned_type>(t)
+                                              ^ sign_bit);
+        } else {
+            return static_cast<unsigned_type>(t);
+        }
+    }
+
+    // Only for integral keys, since floating point keys lose -0.0.
+    static constexpr T decode(unsigned_type u)
+        requires(!std::floating_point<T>)
+    {
+        if constexpr (std::is_enum_v<T>) {
+            using underlying = std::underlying_type_t<T>;
+            return static_cast<T>(radix_key_traits<underlying>::decode(u));
+        } else if constexpr (std::is_signed_v<T>) {
+            return static_cast<T>(static_cast<unsigned_type>(u ^ sign_bit));
+        } else {
+            return static_cast<T>(u);
+        }
+    }
+};
+
+template <typename F>
+inline constexpr int radix_direction = 0;
+template <>
+inline constexpr int radix_direction<std::ranges::less> = 1;
+template <>
+inline constexpr int radix_direction<std::less<>> = 1;
+template <>
+inline constexpr int radix_direction<std::ranges::greater> = -1;
+template <>
+inline constexpr int radix_direction<std::greater<>> = -1;
+
+// A range can be radix sorted when the comparison is less or greater,
+// including composer::less_than and composer::greater_than, and the keys are
+// integers, enums or floating point values.
+template <typename I, typename Comp, typename Proj>
+concept radix_sortable
+    = radix_direction<predicate_core_t<Comp>> != 0
+   && radix_key<std::remove_cvref_t<std::indirect_result_t<Proj&, I>>>;
+
+// Sorts items by key_of(item), least significant byte first, with one
+// counting pass per byte. The counts for all bytes are made in one pass over
+// the items, and bytes that are the same in all keys are skipped.
+template <typename Item, typename KeyOf>
+void lsd_radix_sort(std::vector<Item>& items, const KeyOf& key_of)
+{
+    using key_type = std::invoke_result_t<const KeyOf&, const Item&>;
+    constexpr std::size_t digits = sizeof(key_type);
+    if (items.size() < 2) {
+        return;
+    }
+    const auto digit = [](key_type key, std::size_t d) {
+        return static_cast<std::size_t>((key >> (8 * d)) & 0xff);
+    };
+    std::array<std::array<std::size_t, 256>, digits> counts{};
+    for (const auto& item : items) {
+        const auto key = key_of(item);
+        for (std::size_t d = 0; d != digits; ++d) {
+            ++counts[d][digit(key, d)];
+        }
+    }
+    std::vector<Item> buffer(items.size());
+    for (std::size_t d = 0; d != digits; ++d) {
+        auto& count = counts[d];
+        if (count[digit(key_of(items.front()), d)] == items.size()) {
+            continue;
+        }
+        std::size_t offset = 0;
+        for (auto& c : count) {
+            c = std::exchange(offset, offset + c);
+        }
+        for (auto& item : items) {
+            buffer[count[digit(key_of(item), d)]++] = std::move(item);
+        }
+        items.swap(buffer);
+    }
+}
+
+template <int Direction, typename T>
+constexpr auto radix_encode(const T& t)
+{
+    const auto u = radix_key_traits<T>::encode(t);
+    return Direction < 0 ? static_cast<decltype(u)>(~u) : u;
+}
+
+// Sorts the n elements from first, which are integers or enums, by sorting
+// their encodings and decoding them back.
+template <int Direction, typename I>
+void radix_sort_values(I first, std::size_t n)
+{
+    using value_type = std::iter_value_t<I>;
+    using traits = radix_key_traits<value_type>;
+    std::vector<typename traits::unsigned_type> keys;
+    keys.reserve(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        keys.push_back(radix_encode<Direction>(value_type(first[i])));
+    }
+    lsd_radix_sort(keys, std::identity{});
+    for (std::size_t i = 0; i != n; ++i) {
+        const auto key = keys[i];
+        first[i] = traits::decode(
+            static_cast<typename traits::unsigned_type>(
+                Direction < 0 ? ~key : key));
+    }
+}
+
+template <typename U>
+struct radix_item {
+    U key;
+    std::size_t index;
+};
+
+// Returns the order of the n elements from first, sorted by proj, such that
+// element order[i] goes to position i. Equal keys keep their order.
+template <int Direction, typename I, typename Proj>
+std::vector<std::size_t> radix_sorted_order(I first, std::size_t n, Proj& proj)
+{
+    using key_type = std::remove_cvref_t<std::indirect_result_t<Proj&, I>>;
+    using item = radix_item<typename radix_key_traits<key_type>::unsigned_type>;
+    std::vector<item> items;
+    items.reserve(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        items.push_back(
+            { radix_encode<Direction>(key_type(std::invoke(proj, first[i]))),
+              i });
+    }
+    lsd_radix_sort(items, [](const item& x) { return x.key; });
+    std::vector<std::size_t> order;
+    order.reserve(n);
+    for (const auto& x : items) {
+        order.push_back(x.index);
+    }
+    return order;
+}
+
+} // namespace internal
+} // namespace composer
+
+#endif // COMPOSER_RADIX_SORT_HPP
@@ -0,0 +1,134 @@
+#ifndef COMPOSER_SEARCH_CURSOR_HPP
+#define COMPOSER_SEARCH_CURSOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+namespace composer {
+namespace internal {
+
+// Returns the first element in [first, last) for which before is false,
+// given that it is true for a prefix of the range, by probing 1, 2, 4, ...
+// elements ahead, and then searching between the last two probes.
+template <typename I, typename Pred>
+constexpr I gallop(I first, I last, Pred before)
+{
+    using difference = std::iter_difference_t<I>;
+    const difference n = last - first;
+    difference lo = 0;
+    difference hi = 1;
+    while (hi <= n && before(first[hi - 1])) {
+        lo = hi;
+        hi *= 2;
+    }
+    return std::ranges::partition_point(
+        first + lo, first + std::min(hi, n), before);
+}
+
+} // namespace internal
+
+// Searches a sorted random access range from where the previous search
+// ended, with galloping search, so that a search that moves d elements
+// takes O(log d) comparisons. Searching for m increasing values, e.g. when
+// joining two sorted sequences, takes O(m log(n / m)) comparisons, instead
+// of the O(m log n) of searching the whole range each time. Values before
+// the previous one are found by galloping backwards, so any order of values
+// gives the right results, only slower when the order jumps around.
+template <std::ranges::random_access_range R,
+          typename Comp = std::ranges::less,
+          typename Proj = std::identity>
+    requires std::ranges::sized_range<R>
+class search_cursor {
+public:
+    using iterator = std::ranges::iterator_t<R>;
+
+    explicit search_cursor(R& r, Comp comp = {}, Proj proj = {})
+        : first_(std::ranges::begin(r)),
+          last_(first_ + std::ranges::distance(r)),
+          position_(first_),
+          comp_(std::move(comp)),
+          proj_(std::move(proj))
+    {
+    }
+
+    // The first element not less than value.
+    template <typename T>
+        requires std::indirect_strict_weak_order<
+            Comp&,
+            const T*,
+            std::projected<iterator, Proj&>>
+    iterator lower_bound(const T& value)
+    {
+        return seek([&](auto&& x) {
+            return std::invoke(comp_, std::invoke(proj_, x), value);
+        });
+    }
+
+    // The first element greater than value.
+    template <typename T>
+        requires std::indirect_strict_weak_order<
+            Comp&,
+            const T*,
+            std::projected<iterator, Proj&>>
+    iterator upper_bound(const T& value)
+    {
+        return seek([&](auto&& x) {
+            return !std::invoke(comp_, value, std::invoke(proj_, x));
+        });
+    }
+
+    // Whether there is an element equal to value, leaving the cursor at the
+    // first element not less than value.
+    template <typename T>
+        requires std::indirect_strict_weak_order<
+            Comp&,
+            const T*,
+            std::projected<iterator, Proj&>>
+    bool contains(const T& value)
+    {
+        const auto found = lower_bound(value);
+        return found != last_
+            && !std::invoke(comp_, value, std::invoke(proj_, *found));
+    }
+
+    // Where the previous search ended.
+    iterator position() const { return position_; }
+
+    // Makes the next search start from the beginning of the range.
+    void reset() { position_ = first_; }
+
+private:
+    // Moves the cursor to the first element for which before is false,
+    // forwards if the element before the cursor is before, and backwards
+    // otherwise.
+    template <typename Before>
+    iterator seek(Before before)
+    {
+        if (position_ == first_ || before(*std::prev(position_))) {
+            position_ = internal::gallop(position_, last_, before);
+        } else {
+            const auto not_before = [&](auto&& x) {
+                return !before(std::forward<decltype(x)>(x));
+            };
+            position_ = internal::gallop(std::make_reverse_iterator(position_),
+                                         std::make_reverse_iterator(first_),
+                                         not_before)
+                            .base();
+        }
+        return position_;
+    }
+
+    iterator first_;
+    iterator last_;
+    iterator position_;
+    [[no_unique_address]] Comp comp_;
+    [[no_unique_address]] Proj proj_;
+};
+
+} // namespace composer
+
+#endif // COMPOSER_SEARCH_CURSOR_HPP
@@ -0,0 +1,305 @@
+#ifndef COMPOSER_SEARCH_INDEX_HPP
+#define COMPOSER_SEARCH_INDEX_HPP
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace composer {
+namespace internal {
+
+inline void prefetch(const void* p) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+inline constexpr std::size_t cache_line_size = 64;
+
+// Allocates storage that starts at a cache line.
+template <typename T>
+struct cache_line_allocator {
+    using value_type = T;
+
+    static constexpr std::align_val_t alignment{
+        alignof(T) > cache_line_size ? alignof(T) : cache_line_size
+    };
+
+    cache_line_allocator() = default;
+
+    template <typename U>
+    cache_line_allocator(const cache_line_allocator<U>&) noexcept
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), alignment));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        ::operator delete(p, alignment);
+    }
+
+    template <typename U>
+    bool operator==(const cache_line_allocator<U>&) const noexcept
+    {
+        return true;
+    }
+};
+
+} // namespace internal
+
+// The keys of a sorted random access range, projected with proj, stored in
+// Eytzinger order, i.e. as a binary search tree laid out breadth first,
+// where the children of node k are nodes 2k and 2k + 1. The nodes visited
+// first are close together at the start, instead of spread out over the
+// whole range, and the descendants a few levels down from a node are
+// adjacent, and start a cache line when the keys are a power of two bytes
+// in size, so they are prefetched while the search goes down to them.
+//
+// A search_index is a range of the elements of the indexed range, and
+// composer::lower_bound, upper_bound, binary_search and equal_range search
+// it through the index, comparing values with the keys, when they are
+// called without a projection. The index is a copy of the keys, so it must
+// be rebuilt when the keys in the range change.
+template <std::ranges::random_access_range R, typename Proj = std::identity>
+    requires std::ranges::sized_range<R>
+          && std::copyable<std::remove_cvref_t<
+              std::indirect_result_t<Proj&, std::ranges::iterator_t<R>>>>
+class search_index {
+public:
+    using iterator = std::ranges::iterator_t<R>;
+    using key_type = std::remove_cvref_t<
+        std::indirect_result_t<Proj&, std::ranges::iterator_t<R>>>;
+
+    explicit search_index(R& r, Proj proj = {})
+        : first_(std::ranges::begin(r)),
+          ranks_(static_cast<std::size_t>(std::ranges::size(r)))
+    {
+        std::size_t rank = 0;
+        place(1, rank);
+        keys_.reserve(ranks_.size() + 1);
+        if (!ranks_.empty()) {
+            keys_.push_back(std::invoke(proj, first_[diff(ranks_[0])]));
+        }
+        for (const auto position : ranks_) {
+            keys_.push_back(std::invoke(proj, first_[diff(position)]));
+        }
+    }
+
+    iterator begin() const { return first_; }
+
+    iterator end() const { return first_ + diff(size()); }
+
+    std::size_t size() const noexcept { return ranks_.size(); }
+
+    bool empty() const noexcept { return ranks_.empty(); }
+
+    // The first element whose key is not less than value.
+    template <typename T, typename Comp = std::ranges::less>
+        requires std::indirect_strict_weak_order<Comp,
+                                                 const T*,
+                                                 const key_type*>
+    iterator lower_bound(const T& value, Comp comp = {}) const
+    {
+        return at(descend([&](const key_type& key) {
+            return std::invoke(comp, key, value);
+        }));
+    }
+
+    // The first element whose key is greater than value.
+    template <typename T, typename Comp = std::ranges::less>
+        requires std::indirect_strict_weak_order<Comp,
+                                                 const T*,
+                                                 const key_type*>
+    iterator upper_bound(const T& value, Comp comp = {}) const
+    {
+        return at(descend([&](const key_type& key) {
+            return !std::invoke(comp, value, key);
+        }));
+    }
+
+    template <typename T, typename Comp = std::ranges::less>
+        requires std::indirect_strict_weak_order<Comp,
+                                                 const T*,
+                                                 const key_type*>
+    bool contains(const T& value, Comp comp = {}) const
+    {
+        const auto node = descend([&](const key_type& key) {
+            return std::invoke(comp, key, value);
+        });
+        return node != 0 && !std::invoke(comp, value, keys_[node]);
+    }
+
+private:
+    // The number of levels below a node whose descendants fit in a cache
+    // line, e.g. 4 for 4 byte keys, where the 16 descendants of node k four
+    // levels down are nodes 16k to 16k + 15, at bytes 64k to 64k + 63.
+    static constexpr int prefetch_levels
+        = sizeof(key_type) < internal::cache_line_size
+            ? static_cast<int>(std::bit_width(internal::cache_line_size
+                                              / sizeof(key_type)))
+                  - 1
+            : 0;
+
+    // Whether the descendants can straddle two cache lines, which they do
+    // at some nodes when their size does not divide the line.
+    static constexpr bool prefetch_last
+        = !std::has_single_bit(sizeof(key_type)) && prefetch_levels > 0;
+
+    static constexpr auto diff(std::size_t n)
+    {
+        return static_cast<std::iter_difference_t<iterator>>(n);
+    }
+
+    // Numbers the nodes of the subtree at node k in order, from rank.
+    void place(std::size_t k, std::size_t& rank)
+    {
+        if (k > ranks_.size()) {
+            return;
+        }
+        place(2 * k, rank);
+        ranks_[k - 1] = rank++;
+        place(2 * k + 1, rank);
+    }
+
+    // Goes down the tree, right from the nodes whose keys are before the
+    // searched position, and left from the others, and returns the last
+    // node it went left from, or 0 if it only went right.
+    template <typename Before>
+    std::size_t descend(Before before) const
+    {
+        const std::size_t n = size();
+        std::size_t k = 1;
+        while (k <= n) {
+            const std::size_t ahead = k << prefetch_levels;
+            if (ahead <= n) {
+                internal::prefetch(keys_.data() + ahead);
+                if constexpr (prefetch_last) {
+                    const std::size_t last
+                        = ahead + (std::size_t{ 1 } << prefetch_levels) - 1;
+                    internal::prefetch(keys_.data() + (last < n ? last : n));
+                }
+            }
+            k = 2 * k + static_cast<std::size_t>(before(keys_[k]));
+        }
+        // The right turns at the end are the trailing ones of k, and the
+        // left turn before them is the node.
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    iterator at(std::size_t node) const
+    {
+        return first_ + diff(node == 0 ? size() : ranks_[node - 1]);
+    }
+
+    iterator first_;
+    // ranks_[k - 1] is the position in the range of node k.
+    std::vector<std::size_t> ranks_;
+    // keys_[k] is the key of node k, and keys_[0] is a copy of the root's.
+    std::vector<key_type, internal::cache_line_allocator<key_type>> keys_;
+};
+
+namespace internal {
+
+template <typename T>
+inline constexpr bool is_search_index = false;
+
+template <typename R, typename Proj>
+inline constexpr bool is_search_index<search_index<R, Proj>> = true;
+
+// An index that the binary search algorithms search through, instead of
+// searching its elements, when they are called without a projection.
+template <typename Index, typename T, typename Comp, typename Proj>
+concept index_searchable
+    = is_search_index<std::remove_cvref_t<Index>>
+   && std::same_as<Proj, std::identity>
+   && requires(const std::remove_cvref_t<Index>& index,
+               const T& value,
+               Comp comp) {
+          index.lower_bound(value, comp);
+          index.upper_bound(value, comp);
+          index.contains(value, comp);
+      };
+
+// Searches an index, for the binary search algorithms, which call the
+// std::ranges algorithms for other ranges.
+struct index_lower_bound {
+    template <typename Index,
+              typename T,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires index_searchable<Index, T, Comp, Proj>
+    std::ranges::borrowed_iterator_t<Index>
+    operator()(Index&& index,
+               const T& value,
+               Comp comp = {},
+               Proj = {}) const
+    {
+        return index.lower_bound(value, comp);
+    }
+};
+
+struct index_upper_bound {
+    template <typename Index,
+              typename T,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires index_searchable<Index, T, Comp, Proj>
+    std::ranges::borrowed_iterator_t<Index>
+    operator()(Index&& index,
+               const T& value,
+               Comp comp = {},
+               Proj = {}) const
+    {
+        return index.upper_bound(value, comp);
+    }
+};
+
+struct index_binary_search {
+    template <typename Index,
+              typename T,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires index_searchable<Index, T, Comp, Proj>
+    bool operator()(Index&& index,
+                    const T& value,
+                    Comp comp = {},
+                    Proj = {}) const
+    {
+        return index.contains(value, comp);
+    }
+};
+
+struct index_equal_range {
+    template <typename Index,
+              typename T,
+              typename Comp = std::ranges::less,
+              typename Proj = std::identity>
+        requires index_searchable<Index, T, Comp, Proj>
+    std::ranges::borrowed_subrange_t<Index>
+    operator()(Index&& index,
+               const T& value,
+               Comp comp = {},
+               Proj = {}) const
+    {
+        return { index.lower_bound(value, comp),
+                 index.upper_bound(value, comp) };
+    }
+};
+
+} // namespace internal
+} // namespace composer
+
+#endif // COMPOSER_SEARCH_INDEX_HPP
@@ -0,0 +1,800 @@
+#ifndef COMPOSER_SIMD_HPP
+#define COMPOSER_SIMD_HPP
+
+#include "predicate.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+#endif
+
+namespace composer {
+namespace internal {
+namespace simd {
+
+template <typename T>
+concept element
+    = (std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= 8)
+   || std::same_as<T, float> || std::same_as<T, double>;
+
+// How the kernels compare the elements with the value: element == value,
+// element < value or element > value.
+enum class relation { equal, less, greater };
+
+template <relation Rel, typename V, typename T>
+constexpr bool related(const V& element, const T& value)
+{
+    if constexpr (Rel == relation::equal) {
+        return std::ranges::equal_to{}(element, value);
+    } else if constexpr (Rel == relation::less) {
+        return std::ranges::less{}(element, value);
+    } else {
+        return std::ranges::greater{}(element, value);
+    }
+}
+
+// The instruction set is chosen when compiling, from the target flags, e.g.
+// -mavx2 or -march=native. compare_mask<Rel>(p, value) compares the
+// vector_bytes bytes at p with value, and returns a mask with mask_bits<T>
+// bits set for each element that is related to value by Rel.
+// count_related<Rel>(p, vectors, value) returns the number of elements
+// related to value in the vectors * vector_bytes bytes at p.
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+
+inline constexpr std::size_t vector_bytes = 64;
+
+template <typename T>
+inline constexpr int mask_bits = 1;
+
+template <relation Rel, element T>
+std::uint64_t compare_mask(const T* p, T value)
+{
+    if constexpr (std::floating_point<T>) {
+        constexpr int op = Rel == relation::equal ? _CMP_EQ_OQ
+                         : Rel == relation::less  ? _CMP_LT_OQ
+                                                  : _CMP_GT_OQ;
+        if constexpr (std::same_as<T, float>) {
+            return _mm512_cmp_ps_mask(
+                _mm512_loadu_ps(p), _mm512_set1_ps(value), op);
+        } else {
+            return _mm512_cmp_pd_mask(
+                _mm512_loadu_pd(p), _mm512_set1_pd(value), op);
+        }
+    } else {
+        constexpr int op = Rel == relation::equal ? _MM_CMPINT_EQ
+                         : Rel == relation::less  ? _MM_CMPINT_LT
+                                                  : _MM_CMPINT_NLE;
+        const auto v = _mm512_loadu_si512(p);
+        if constexpr (sizeof(T) == 1) {
+            const auto w = _mm512_set1_epi8(static_cast<char>(value));
+            if constexpr (std::unsigned_integral<T>) {
+                return _mm512_cmp_epu8_mask(v, w, op);
+            } else {
+                return _mm512_cmp_epi8_mask(v, w, op);
+            }
+        } else if constexpr (sizeof(T) == 2) {
+            const auto w = _mm512_set1_epi16(static_cast<short>(value));
+            if constexpr (std::unsigned_integral<T>) {
+                return _mm512_cmp_epu16_mask(v, w, op);
+            } else {
+                return _mm512_cmp_epi16_mask(v, w, op);
+            }
+        } else if constexpr (sizeof(T) == 4) {
+            const auto w = _mm512_set1_epi32(static_cast<int>(value));
+            if constexpr (std::unsigned_integral<T>) {
+                return _mm512_cmp_epu32_mask(v, w, op);
+            } else {
+                return _mm512_cmp_epi32_mask(v, w, op);
+            }
+        } else {
+            const auto w = _mm512_set1_epi64(static_cast<long long>(value));
+            if constexpr (std::unsigned_integral<T>) {
+                return _mm512_cmp_epu64_mask(v, w, op);
+            } else {
+                return _mm512_cmp_epi64_mask(v, w, op);
+            }
+        }
+    }
+}
+
+template <relation Rel, element T>
+std::size_t count_related(const T* p, std::size_t vectors, T value)
+{
+    constexpr std::size_t lanes = vector_bytes / sizeof(T);
+    std::size_t n = 0;
+    for (; vectors != 0; --vectors, p += lanes) {
+        n += static_cast<std::size_t>(
+            std::popcount(compare_mask<Rel>(p, value)));
+    }
+    return n;
+}
+
+#elif defined(__AVX2__)
+
+inline constexpr std::size_t vector_bytes = 32;
+
+// one bit per byte
+template <typename T>
+inline constexpr int mask_bits = sizeof(T);
+
+template <typename T>
+__m256i broadcast(T value)
+{
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_set1_epi8(static_cast<char>(value));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_set1_epi16(static_cast<short>(value));
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_set1_epi32(static_cast<int>(value));
+    } else {
+        return _mm256_set1_epi64x(static_cast<long long>(value));
+    }
+}
+
+// all bits are set in the elements that are related
+template <relation Rel, element T>
+__m256i compare_vector(const T* p, T value)
+{
+    if constexpr (std::floating_point<T>) {
+        constexpr int op = Rel == relation::equal ? _CMP_EQ_OQ
+                         : Rel == relation::less  ? _CMP_LT_OQ
+                                                  : _CMP_GT_OQ;
+        if constexpr (std::same_as<T, float>) {
+            return _mm256_castps_si256(
+                _mm256_cmp_ps(_mm256_loadu_ps(p), _mm256_set1_ps(value), op));
+        } else {
+            return _mm256_castpd_si256(
+                _mm256_cmp_pd(_mm256_loadu_pd(p), _mm256_set1_pd(value), op));
+        }
+    } else {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        auto w = broadcast(value);
+        if constexpr (Rel == relation::equal) {
+            if constexpr (sizeof(T) == 1) {
+                return _mm256_cmpeq_epi8(v, w);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm256_cmpeq_epi16(v, w);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm256_cmpeq_epi32(v, w);
+            } else {
+                return _mm256_cmpeq_epi64(v, w);
+            }
+        } else {
+            if constexpr (std::unsigned_integral<T>) {
+                // flipping the sign bits orders unsigned values as signed
+                const auto sign = broadcast(
+                    static_cast<T>(std::numeric_limits<T>::max() / 2 + 1));
+                v = _mm256_xor_si256(v, sign);
+                w = _mm256_xor_si256(w, sign);
+            }
+            if constexpr (Rel == relation::less) {
+                std::swap(v, w);
+            }
+            if constexpr (sizeof(T) == 1) {
+                return _mm256_cmpgt_epi8(v, w);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm256_cmpgt_epi16(v, w);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm256_cmpgt_epi32(v, w);
+            } else {
+                return _mm256_cmpgt_epi64(v, w);
+            }
+        }
+    }
+}
+
+template <relation Rel, element T>
+std::uint64_t compare_mask(const T* p, T value)
+{
+    return static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(compare_vector<Rel>(p, value)));
+}
+
+// The related bytes are counted in 8 bit lanes, by subtracting the all ones
+// (-1) bytes, and the lanes are summed before they can overflow.
+template <relation Rel, element T>
+std::size_t count_related(const T* p, std::size_t vectors, T value)
+{
+    constexpr std::size_t lanes = vector_bytes / sizeof(T);
+    std::size_t bytes = 0;
+    while (vectors != 0) {
+        const auto block = std::min<std::size_t>(vectors, 255);
+        auto acc = _mm256_setzero_si256();
+        for (std::size_t i = 0; i != block; ++i, p += lanes) {
+            acc = _mm256_sub_epi8(acc, compare_vector<Rel>(p, value));
+        }
+        const auto sums = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+        bytes += static_cast<std::size_t>(_mm256_extract_epi16(sums, 0))
+               + static_cast<std::size_t>(_mm256_extract_epi16(sums, 4))
+               + static_cast<std::size_t>(_mm256_extract_epi16(sums, 8))
+               + static_cast<std::size_t>(_mm256_extract_epi16(sums, 12));
+        vectors -= block;
+    }
+    return bytes / sizeof(T);
+}
+
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+inline constexpr std::size_t vector_bytes = 16;
+
+// one bit per byte
+template <typename T>
+inline constexpr int mask_bits = sizeof(T);
+
+template <typename T>
+__m128i broadcast(T value)
+{
+    if constexpr (sizeof(T) == 1) {
+        return _mm_set1_epi8(static_cast<char>(value));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_set1_epi16(static_cast<short>(value));
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm_set1_epi32(static_cast<int>(value));
+    } else {
+        return _mm_set1_epi64x(static_cast<long long>(value));
+    }
+}
+
+// signed 64 bit v > w
+inline __m128i greater_epi64(__m128i v, __m128i w)
+{
+#if defined(__SSE4_2__)
+    return _mm_cmpgt_epi64(v, w);
+#else
+    // The high halves decide, unless they are equal, and then the low
+    // halves, compared as unsigned by flipping their sign bits.
+    constexpr int sign = std::numeric_limits<int>::min();
+    const auto low_sign = _mm_set_epi32(0, sign, 0, sign);
+    v = _mm_xor_si128(v, low_sign);
+    w = _mm_xor_si128(w, low_sign);
+    const auto gt = _mm_cmpgt_epi32(v, w);
+    const auto eq = _mm_cmpeq_epi32(v, w);
+    const auto low_gt = _mm_shuffle_epi32(gt, _MM_SHUFFLE(2, 2, 0, 0));
+    const auto high = _mm_or_si128(gt, _mm_and_si128(eq, low_gt));
+    return _mm_shuffle_epi32(high, _MM_SHUFFLE(3, 3, 1, 1));
+#endif
+}
+
+// all bits are set in the elements that are related
+template <relation Rel, element T>
+__m128i compare_vector(const T* p, T value)
+{
+    if constexpr (std::same_as<T, float>) {
+        const auto v = _mm_loadu_ps(p);
+        const auto w = _mm_set1_ps(value);
+        return _mm_castps_si128(Rel == relation::equal ? _mm_cmpeq_ps(v, w)
+                                : Rel == relation::less ? _mm_cmplt_ps(v, w)
+                                                        : _mm_cmpgt_ps(v, w));
+    } else if constexpr (std::same_as<T, double>) {
+        const auto v = _mm_loadu_pd(p);
+        const auto w = _mm_set1_pd(value);
+        return _mm_castpd_si128(Rel == relation::equal ? _mm_cmpeq_pd(v, w)
+                                : Rel == relation::less ? _mm_cmplt_pd(v, w)
+                                                        : _mm_cmpgt_pd(v, w));
+    } else {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto w = broadcast(value);
+        if constexpr (Rel == relation::equal) {
+            if constexpr (sizeof(T) == 1) {
+                return _mm_cmpeq_epi8(v, w);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm_cmpeq_epi16(v, w);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm_cmpeq_epi32(v, w);
+            } else {
+#if defined(__SSE4_1__)
+                return _mm_cmpeq_epi64(v, w);
+#else
+                // both 32 bit halves must be equal
+                const auto eq = _mm_cmpeq_epi32(v, w);
+                return _mm_and_si128(
+                    eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+#endif
+            }
+        } else {
+            if constexpr (std::unsigned_integral<T>) {
+                // flipping the sign bits orders unsigned values as signed
+                const auto sign = broadcast(
+                    static_cast<T>(std::numeric_limits<T>::max() / 2 + 1));
+                v = _mm_xor_si128(v, sign);
+                w = _mm_xor_si128(w, sign);
+            }
+            if constexpr (Rel == relation::less) {
+                std::swap(v, w);
+            }
+            if constexpr (sizeof(T) == 1) {
+                return _mm_cmpgt_epi8(v, w);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm_cmpgt_epi16(v, w);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm_cmpgt_epi32(v, w);
+            } else {
+                return greater_epi64(v, w);
+            }
+        }
+    }
+}
+
+template <relation Rel, element T>
+std::uint64_t compare_mask(const T* p, T value)
+{
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(compare_vector<Rel>(p, value)));
+}
+
+// The related bytes are counted in 8 bit lanes, by subtracting the all ones
+// (-1) bytes, and the lanes are summed before they can overflow.
+template <relation Rel, element T>
+std::size_t count_related(const T* p, std::size_t vectors, T value)
+{
+    constexpr std::size_t lanes = vector_bytes / sizeof(T);
+    std::size_t bytes = 0;
+    while (vectors != 0) {
+        const auto block = std::min<std::size_t>(vectors, 255);
+        auto acc = _mm_setzero_si128();
+        for (std::size_t i = 0; i != block; ++i, p += lanes) {
+            acc = _mm_sub_epi8(acc, compare_vector<Rel>(p, value));
+        }
+        const auto sums = _mm_sad_epu8(acc, _mm_setzero_si128());
+        bytes += static_cast<std::size_t>(_mm_extract_epi16(sums, 0))
+               + static_cast<std::size_t>(_mm_extract_epi16(sums, 4));
+        vectors -= block;
+    }
+    return bytes / sizeof(T);
+}
+
+#else
+
+inline constexpr std::size_t vector_bytes = 0;
+
+// never called, the scalar loops are used instead
+
+template <typename T>
+inline constexpr int mask_bits = 1;
+
+template <relation Rel, element T>
+std::uint64_t compare_mask(const T* p, T value);
+
+template <relation Rel, element T>
+std::size_t count_related(const T* p, std::size_t vectors, T value);
+
+#endif
+
+// The number of bits in the mask of a vector of T, and the mask with all
+// of them set.
+template <element T>
+inline constexpr std::size_t mask_width
+    = vector_bytes / sizeof(T) * static_cast<std::size_t>(mask_bits<T>);
+
+template <element T>
+inline constexpr std::uint64_t full_mask
+    = mask_width<T> >= 64 ? ~std::uint64_t{}
+                          : (std::uint64_t{ 1 } << mask_width<T>) - 1;
+
+// Four vectors are compared per iteration, so that the loop is limited by
+// memory bandwidth rather than by the branch for each vector.
+inline constexpr std::size_t unroll = 4;
+
+// Finds the first element related to value by Rel, or the first that is
+// not, when Negate.
+template <relation Rel = relation::equal, bool Negate = false, element T>
+const T* find(const T* first, const T* last, T value)
+{
+    if constexpr (vector_bytes != 0) {
+        constexpr std::size_t lanes = vector_bytes / sizeof(T);
+        constexpr std::uint64_t flip = Negate ? full_mask<T> : 0;
+        while (static_cast<std::size_t>(last - first) >= unroll * lanes) {
+            std::uint64_t masks[unroll];
+            std::uint64_t any = 0;
+            for (std::size_t i = 0; i != unroll; ++i) {
+                masks[i] = compare_mask<Rel>(first + i * lanes, value) ^ flip;
+                any |= masks[i];
+            }
+            if (any != 0) {
+                for (std::size_t i = 0;; ++i) {
+                    if (masks[i] != 0) {
+                        return first + i * lanes
+                             + std::countr_zero(masks[i]) / mask_bits<T>;
+                    }
+                }
+            }
+            first += unroll * lanes;
+        }
+        while (static_cast<std::size_t>(last - first) >= lanes) {
+            if (const auto mask = compare_mask<Rel>(first, value) ^ flip) {
+                return first + std::countr_zero(mask) / mask_bits<T>;
+            }
+            first += lanes;
+        }
+    }
+    for (; first != last; ++first) {
+        if (related<Rel>(*first, value) != Negate) {
+            return first;
+        }
+    }
+    return last;
+}
+
+template <relation Rel = relation::equal, element T>
+std::ptrdiff_t count(const T* first, const T* last, T value)
+{
+    std::size_t n = 0;
+    if constexpr (vector_bytes != 0) {
+        constexpr std::size_t lanes = vector_bytes / sizeof(T);
+        const auto vectors = static_cast<std::size_t>(last - first) / lanes;
+        n = count_related<Rel>(first, vectors, value);
+        first += vectors * lanes;
+    }
+    for (; first != last; ++first) {
+        n += related<Rel>(*first, value);
+    }
+    return static_cast<std::ptrdiff_t>(n);
+}
+
+} // namespace simd
+
+// Comparing an element of type V with a value of type T can be done with
+// the SIMD kernels when the types are both integral or both floating point,
+// and the value survives the round trip through V. Otherwise the value is
+// not equal to any V, or the comparison converts the elements, and the
+// result could differ.
+template <typename V, typename T>
+concept vectorizable_equality
+    = simd::element<V>
+   && ((std::integral<V> && std::integral<T> && !std::same_as<T, bool>)
+       || (std::floating_point<V> && std::floating_point<T>));
+
+template <typename V, typename T>
+constexpr std::optional<V> as_element(const T& value)
+{
+    if constexpr (std::floating_point<T> && sizeof(T) > sizeof(V)) {
+        if (!(value >= std::numeric_limits<V>::lowest()
+              && value <= std::numeric_limits<V>::max())) {
+            return std::nullopt;
+        }
+    }
+    const auto v = static_cast<V>(value);
+    if (static_cast<T>(v) != value) {
+        return std::nullopt;
+    }
+    return v;
+}
+
+template <typename R, typename T>
+concept vectorizable_range
+    = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+   && vectorizable_equality<std::ranges::range_value_t<R>, T>;
+
+template <typename I, typename S, typename T>
+concept vectorizable_iterators
+    = std::contiguous_iterator<I> && std::sized_sentinel_for<S, I>
+   && vectorizable_equality<std::iter_value_t<I>, T>;
+
+// Ordering is done as for equality, except when the comparison converts
+// signed elements to an unsigned type, which orders negative elements after
+// the others.
+template <simd::relation Rel, typename V, typename T>
+concept vectorizable_relation
+    = vectorizable_equality<V, T>
+   && (Rel == simd::relation::equal
+       || !(std::signed_integral<V>
+            && std::unsigned_integral<std::common_type_t<V, T>>));
+
+// The vectorized algorithms accept the same arguments as the std::ranges
+// algorithms, for contiguous ranges of arithmetic types and no projection.
+
+struct vectorized_find {
+    template <typename I, typename S, typename T>
+        requires vectorizable_iterators<I, S, T>
+    I operator()(I first, S last, const T& value, std::identity = {}) const
+    {
+        const auto v = as_element<std::iter_value_t<I>>(value);
+        if (!v) {
+            return std::ranges::find(first, last, value);
+        }
+        const auto* p = std::to_address(first);
+        return first + (simd::find(p, p + (last - first), *v) - p);
+    }
+
+    template <typename R, typename T>
+        requires vectorizable_range<R, T>
+    std::ranges::borrowed_iterator_t<R>
+    operator()(R&& r, const T& value, std::identity = {}) const
+    {
+        const auto first = std::ranges::begin(r);
+        return (*this)(first, first + std::ranges::ssize(r), value);
+    }
+};
+
+struct vectorized_count {
+    template <typename I, typename S, typename T>
+        requires vectorizable_iterators<I, S, T>
+    std::iter_difference_t<I>
+    operator()(I first, S last, const T& value, std::identity = {}) const
+    {
+        const auto v = as_element<std::iter_value_t<I>>(value);
+        if (!v) {
+            return std::ranges::count(first, last, value);
+        }
+        const auto* p = std::to_address(first);
+        return static_cast<std::iter_difference_t<I>>(
+            simd::count(p, p + (last - first), *v));
+    }
+
+    template <typename R, typename T>
+        requires vectorizable_range<R, T>
+    std::ranges::range_difference_t<R>
+    operator()(R&& r, const T& value, std::identity = {}) const
+    {
+        const auto first = std::ranges::begin(r);
+        return (*this)(first, first + std::ranges::ssize(r), value);
+    }
+};
+
+struct vectorized_contains {
+    template <typename I, typename S, typename T>
+        requires vectorizable_iterators<I, S, T>
+    bool operator()(I first, S last, const T& value, std::identity = {}) const
+    {
+        return vectorized_find{}(first, last, value) != last;
+    }
+
+    template <typename R, typename T>
+        requires vectorizable_range<R, T>
+    bool operator()(R&& r, const T& value, std::identity = {}) const
+    {
+        const auto first = std::ranges::begin(r);
+        const auto last = first + std::ranges::ssize(r);
+        return vectorized_find{}(first, last, value) != last;
+    }
+};
+
+struct vectorized_count_not_equal {
+    template <typename I, typename S, typename T>
+        requires vectorizable_iterators<I, S, T>
+    std::iter_difference_t<I>
+    operator()(I first, S last, const T& value, std::identity = {}) const
+    {
+        return (last - first) - vectorized_count{}(first, last, value);
+    }
+
+    template <typename R, typename T>
+        requires vectorizable_range<R, T>
+    std::ranges::range_difference_t<R>
+    operator()(R&& r, const T& value, std::identity = {}) const
+    {
+        return std::ranges::ssize(r) - vectorized_count{}(r, value);
+    }
+};
+
+// Finds the first element related to value by Rel, or the first that is
+// not, when Negate, for the predicates of find_if and find_if_not.
+template <simd::relation Rel, bool Negate = false>
+struct vectorized_find_where {
+    template <typename I, typename S, typename T>
+        requires std::contiguous_iterator<I> && std::sized_sentinel_for<S, I>
+              && vectorizable_relation<Rel, std::iter_value_t<I>, T>
+    I operator()(I first, S last, const T& value) const
+    {
+        const auto v = as_element<std::iter_value_t<I>>(value);
+        if (!v) {
+            return std::ranges::find_if(first, last, [&](const auto& e) {
+                return simd::related<Rel>(e, value) != Negate;
+            });
+        }
+        const auto* p = std::to_address(first);
+        return first
+             + (simd::find<Rel, Negate>(p, p + (last - first), *v) - p);
+    }
+
+    template <typename R, typename T>
+        requires std::ranges::contiguous_range<R>
+              && std::ranges::sized_range<R>
+              && vectorizable_relation<Rel, std::ranges::range_value_t<R>, T>
+    std::ranges::borrowed_iterator_t<R> operator()(R&& r, const T& value) const
+    {
+        const auto first = std::ranges::begin(r);
+        return (*this)(first, first + std::ranges::ssize(r), value);
+    }
+};
+
+template <simd::relation Rel, bool Negate = false>
+struct vectorized_contains_where {
+    using find = vectorized_find_where<Rel, Negate>;
+
+    template <typename I, typename S, typename T>
+        requires std::is_invocable_v<const find&, I, S, const T&>
+    bool operator()(I first, S last, const T& value) const
+    {
+        return find{}(first, last, value) != last;
+    }
+
+    template <typename R, typename T>
+        requires std::is_invocable_v<const find&, R, const T&>
+    bool operator()(R&& r, const T& value) const
+    {
+        const auto first = std::ranges::begin(r);
+        const auto last = first + std::ranges::ssize(r);
+        return find{}(first, last, value) != last;
+    }
+};
+
+template <simd::relation Rel>
+struct vectorized_count_where {
+    template <typename I, typename S, typename T>
+        requires std::contiguous_iterator<I> && std::sized_sentinel_for<S, I>
+              && vectorizable_relation<Rel, std::iter_value_t<I>, T>
+    std::iter_difference_t<I> operator()(I first, S last, const T& value) const
+    {
+        const auto v = as_element<std::iter_value_t<I>>(value);
+        if (!v) {
+            return std::ranges::count_if(first, last, [&](const auto& e) {
+                return simd::related<Rel>(e, value);
+            });
+        }
+        const auto* p = std::to_address(first);
+        return static_cast<std::iter_difference_t<I>>(
+            simd::count<Rel>(p, p + (last - first), *v));
+    }
+
+    template <typename R, typename T>
+        requires std::ranges::contiguous_range<R>
+              && std::ranges::sized_range<R>
+              && vectorizable_relation<Rel, std::ranges::range_value_t<R>, T>
+    std::ranges::range_difference_t<R> operator()(R&& r,
+                                                  const T& value) const
+    {
+        const auto first = std::ranges::begin(r);
+        return (*this)(first, first + std::ranges::ssize(r), value);
+    }
+};
+
+template <typename Vectorized>
+struct vectorized_not {
+    template <typename... Ts>
+        requires std::is_invocable_v<const Vectorized&, Ts...>
+    bool operator()(Ts&&... ts) const
+    {
+        return !Vectorized{}(std::forward<Ts>(ts)...);
+    }
+};
+
+template <typename P, predicate_kind Kind>
+concept unprojected_comparison
+    = predicate_kind_v<P> == Kind
+   && std::same_as<predicate_projection_t<P>, std::identity>;
+
+// Accepts the arguments of an algorithm that takes a predicate, like
+// std::ranges::find_if, when the predicate compares with Kind and has no
+// projection, e.g. equal_to(x), and calls Vectorized with the operand, x,
+// instead of the predicate.
+template <predicate_kind Kind, typename Vectorized>
+struct vectorized_with_operand {
+    template <typename I, typename S, typename P>
+        requires unprojected_comparison<P, Kind>
+              && std::is_invocable_v<const Vectorized&,
+                                     I,
+                                     S,
+                                     const predicate_operand_t<P>&>
+    auto operator()(I first, S last, const P& pred, std::identity = {}) const
+    {
+        return Vectorized{}(
+            std::move(first), std::move(last), predicate_operand(pred));
+    }
+
+    template <typename R, typename P>
+        requires unprojected_comparison<P, Kind>
+              && std::is_invocable_v<const Vectorized&,
+                                     R,
+                                     const predicate_operand_t<P>&>
+    auto operator()(R&& r, const P& pred, std::identity = {}) const
+    {
+        return Vectorized{}(std::forward<R>(r), predicate_operand(pred));
+    }
+};
+
+// The overloads of all Fs, which accept different predicates.
+template <typename... Fs>
+struct vectorized_overloads : Fs... {
+    using Fs::operator()...;
+};
+
+using vectorized_find_if = vectorized_overloads<
+    vectorized_with_operand<predicate_kind::equal_to, vectorized_find>,
+    vectorized_with_operand<predicate_kind::less,
+                            vectorized_find_where<simd::relation::less>>,
+    vectorized_with_operand<predicate_kind::greater,
+                            vectorized_find_where<simd::relation::greater>>>;
+
+using vectorized_find_if_not = vectorized_overloads<
+    vectorized_with_operand<predicate_kind::not_equal_to, vectorized_find>,
+    vectorized_with_operand<predicate_kind::less,
+                            vectorized_find_where<simd::relation::less, true>>,
+    vectorized_with_operand<
+        predicate_kind::greater,
+        vectorized_find_where<simd::relation::greater, true>>>;
+
+using vectorized_any_of = vectorized_overloads<
+    vectorized_with_operand<predicate_kind::equal_to, vectorized_contains>,
+    vectorized_with_operand<predicate_kind::less,
+                            vectorized_contains_where<simd::relation::less>>,
+    vectorized_with_operand<
+        predicate_kind::greater,
+        vectorized_contains_where<simd::relation::greater>>>;
+
+using vectorized_none_of = vectorized_overloads<
+    vectorized_with_operand<predicate_kind::equal_to,
+                            vectorized_not<vectorized_contains>>,
+    vectorized_with_operand<
+        predicate_kind::less,
+        vectorized_not<vectorized_contains_where<simd::relation::less>>>,
+    vectorized_with_operand<
+        predicate_kind::greater,
+        vectorized_not<vectorized_contains_where<simd::relation::greater>>>>;
+
+// all_of(p) is none_of(!p)
+using vectorized_all_of = vectorized_overloads<
+    vectorized_with_operand<predicate_kind::not_equal_to,
+                            vectorized_not<vectorized_contains>>,
+    vectorized_with_operand<
+        predicate_kind::less,
+        vectorized_not<
+            vectorized_contains_where<simd::relation::less, true>>>,
+    vectorized_with_operand<
+        predicate_kind::greater,
+        vectorized_not<
+            vectorized_contains_where<simd::relation::greater, true>>>>;
+
+using vectorized_count_if = vectorized_overloads<
+    vectorized_with_operand<predicate_kind::equal_to, vectorized_count>,
+    vectorized_with_operand<predicate_kind::not_equal_to,
+                            vectorized_count_not_equal>,
+    vectorized_with_operand<predicate_kind::less,
+                            vectorized_count_where<simd::relation::less>>,
+    vectorized_with_operand<predicate_kind::greater,
+                            vectorized_count_where<simd::relation::greater>>>;
+
+// Calls Vectorized with ts, if it accepts them, except in constant
+// evaluation, and fallback otherwise.
+template <typename Vectorized, typename Fallback, typename... Ts>
+constexpr auto vectorized_or(const Fallback& fallback, Ts&&... ts)
+    -> std::invoke_result_t<const Fallback&, Ts...>
+{
+    if constexpr (std::is_invocable_v<const Vectorized&, Ts...>) {
+        if !consteval {
+            return Vectorized{}(std::forward<Ts>(ts)...);
+        }
+    }
+    return fallback(std::forward<Ts>(ts)...);
+}
+
+} // namespace internal
+} // namespace composer
+
+#endif // COMPOSER_SIMD_HPP
@@ -0,0 +1,135 @@
+#ifndef COMPOSER_TABULATE_HPP
+#define COMPOSER_TABULATE_HPP
+
+#include "composable_function.hpp"
+
+#include <array>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace composer {
+
+template <std::integral auto Lo, decltype(Lo) Hi>
+    requires(Lo <= Hi)
+struct interval {};
+
+namespace internal {
+
+// A tabulation domain maps each of its size values to an index in [0, size)
+// with index(v), and back with value(i).
+
+template <typename T>
+struct tabulation_domain {};
+
+template <typename T>
+    requires((std::integral<T> || std::is_enum_v<T>) && sizeof(T) == 1
+             && !std::same_as<T, bool>)
+struct tabulation_domain<T> {
+    using value_type = T;
+    using underlying_type =
+        typename std::conditional_t<std::is_enum_v<T>,
+                                    std::underlying_type<T>,
+                                    std::type_identity<T>>::type;
+    using unsigned_type = std::make_unsigned_t<underlying_type>;
+
+    static constexpr std::size_t size = std::size_t{ 1 } << CHAR_BIT;
+
+    static constexpr std::size_t index(T v)
+    {
+        return static_cast<unsigned_type>(static_cast<underlying_type>(v));
+    }
+
+    static constexpr T value(std::size_t i)
+    {
+        return static_cast<T>(
+            static_cast<underlying_type>(static_cast<unsigned_type>(i)));
+    }
+};
+
+template <>
+struct tabulation_domain<bool> {
+    using value_type = bool;
+
+    static constexpr std::size_t size = 2;
+
+    static constexpr std::size_t index(bool v) { return v; }
+
+    static constexpr bool value(std::size_t i) { return i != 0; }
+};
+
+template <std::integral auto Lo, decltype(Lo) Hi>
+struct tabulation_domain<interval<Lo, Hi>> {
+    using value_type = decltype(Lo);
+    using unsigned_type = std::make_unsigned_t<value_type>;
+
+    static constexpr std::size_t size
+        = std::size_t{ static_cast<unsigned_type>(Hi - Lo) } + 1;
+
+    static constexpr std::size_t index(value_type v)
+    {
+        return static_cast<unsigned_type>(v - Lo);
+    }
+
+    static constexpr value_type value(std::size_t i)
+    {
+        return static_cast<value_type>(Lo + static_cast<value_type>(i));
+    }
+};
+
+template <typename Domain>
+concept tabulation_domain_type
+    = requires { tabulation_domain<Domain>::size; };
+
+template <typename Domain, typename F>
+using tabulated_value_t = std::decay_t<std::invoke_result_t<
+    const F&,
+    const typename tabulation_domain<Domain>::value_type&>>;
+
+template <typename Domain, typename Value>
+struct lookup_table {
+    static constexpr bool is_nodiscard = true;
+    using domain = tabulation_domain<Domain>;
+
+    std::array<Value, domain::size> table;
+
+    // Only the domain type itself is accepted, so that e.g. an int is not
+    // silently narrowed to an index into a table for uint8_t.
+    template <typename T>
+        requires std::same_as<std::remove_cvref_t<T>,
+                              typename domain::value_type>
+    constexpr Value operator()(const T& t) const
+    {
+        return table[domain::index(t)];
+    }
+};
+
+template <typename Domain, typename Value, typename F, std::size_t... Is>
+constexpr lookup_table<Domain, Value> make_lookup_table(
+    const F& f, std::index_sequence<Is...>)
+{
+    using domain = tabulation_domain<Domain>;
+    return { { Value(std::invoke(f, domain::value(Is)))... } };
+}
+
+} // namespace internal
+
+template <internal::tabulation_domain_type Domain, typename F>
+[[nodiscard]] constexpr auto tabulate(const F& f)
+    -> composable_function<internal::lookup_table<
+        Domain,
+        internal::tabulated_value_t<Domain, F>>>
+{
+    using value_type = internal::tabulated_value_t<Domain, F>;
+    return { internal::make_lookup_table<Domain, value_type>(
+        f,
+        std::make_index_sequence<
+            internal::tabulation_domain<Domain>::size>{}) };
+}
+
+} // namespace composer
+
+#endif // COMPOSER_TABULATE_HPP
@@ -0,0 +1,230 @@
+#ifndef COMPOSER_THREAD_POOL_HPP
+#define COMPOSER_THREAD_POOL_HPP
+
+#include "function.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace composer {
+
+// An executor runs tasks submitted to it on threads of its own. The parallel
+// algorithms submit their chunks to one, and while waiting for them, call
+// try_run_one, so that a task can itself run a parallel algorithm without
+// every thread of the executor ending up waiting.
+class executor {
+public:
+    virtual ~executor() = default;
+
+    // The number of threads that run submitted tasks.
+    virtual std::size_t concurrency() const noexcept = 0;
+
+    virtual void submit(function<void()> task) = 0;
+
+    // Runs one submitted task on the calling thread, if there is one that
+    // has not started. Returns false if there was none.
+    virtual bool try_run_one() = 0;
+};
+
+enum class cpu_pinning { none, compact };
+
+class thread_pool final : public executor {
+public:
+    explicit thread_pool(std::size_t threads = default_thread_count(),
+                         cpu_pinning pinning = cpu_pinning::none)
+        : queues_(std::max<std::size_t>(threads, 1))
+    {
+        workers_.reserve(queues_.size());
+        for (std::size_t i = 0; i != queues_.size(); ++i) {
+            workers_.emplace_back([this, i, pinning] { work(i, pinning); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // Runs the tasks that are already submitted before the threads stop.
+    ~thread_pool() override
+    {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        workers_.clear();
+    }
+
+    static std::size_t default_thread_count() noexcept
+    {
+        return std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    std::size_t concurrency() const noexcept override
+    {
+        return queues_.size();
+    }
+
+    // A task submitted from a thread of the pool is queued for that thread,
+    // others are spread over the threads. A task that throws terminates the
+    // program.
+    void submit(function<void()> task) override
+    {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            ++pending_;
+        }
+        auto& queue = queues_[own_index().value_or(
+            next_queue_.fetch_add(1, std::memory_order_relaxed)
+            % queues_.size())];
+        {
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    bool try_run_one() override
+    {
+        auto task = take(own_index());
+        if (!task) {
+            return false;
+        }
+        (*task)();
+        return true;
+    }
+
+private:
+    struct queue {
+        std::mutex mutex;
+        std::deque<function<void()>> tasks;
+    };
+
+    struct worker_identity {
+        const thread_pool* pool = nullptr;
+        std::size_t index = 0;
+    };
+
+    static worker_identity& current_worker() noexcept
+    {
+        static thread_local worker_identity identity;
+        return identity;
+    }
+
+    std::optional<std::size_t> own_index() const noexcept
+    {
+        const auto& identity = current_worker();
+        if (identity.pool != this) {
+            return std::nullopt;
+        }
+        return identity.index;
+    }
+
+    // A thread takes the newest task from its own queue, since its data is
+    // most likely still in cache, and steals the oldest from the others,
+    // since those are most likely to split into more work. A thread outside
+    // the pool, with no queue of its own, only steals.
+    std::optional<function<void()>> take(std::optional<std::size_t> own)
+    {
+        const auto first = own.value_or(0);
+        for (std::size_t n = 0; n != queues_.size(); ++n) {
+            auto& queue = queues_[(first + n) % queues_.size()];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            std::optional<function<void()>> task;
+            if (own && n == 0) {
+                task.emplace(std::move(queue.tasks.back()));
+                queue.tasks.pop_back();
+            } else {
+                task.emplace(std::move(queue.tasks.front()));
+                queue.tasks.pop_front();
+            }
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+        return std::nullopt;
+    }
+
+    static void pin(std::size_t index)
+    {
+#if defined(__linux__)
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(index % default_thread_count(), &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#else
+        (void)index;
+#endif
+    }
+
+    void work(std::size_t index, cpu_pinning pinning)
+    {
+        current_worker() = { this, index };
+        if (pinning == cpu_pinning::compact) {
+            pin(index);
+        }
+        for (;;) {
+            if (auto task = take(index)) {
+                (*task)();
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return stop_ || pending_ != 0; });
+            if (stop_ && pending_ == 0) {
+                return;
+            }
+        }
+    }
+
+    std::deque<queue> queues_;
+    std::atomic<std::size_t> next_queue_ = 0;
+    // Incremented with sleep_mutex_ held before a task is queued, so that a
+    // thread cannot miss the wakeup for it.
+    std::atomic<std::size_t> pending_ = 0;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::vector<std::jthread> workers_;
+};
+
+namespace internal {
+inline std::atomic<executor*> default_executor_override = nullptr;
+}
+
+// The executor used by the parallel algorithms when the execution policy
+// does not name one. Unless replaced with set_default_executor, it is a
+// thread pool that is started on first use, with one thread less than the
+// hardware has, since the calling thread takes part in the algorithms.
+inline executor& default_executor()
+{
+    if (auto* e = internal::default_executor_override.load()) {
+        return *e;
+    }
+    static thread_pool pool(thread_pool::default_thread_count() - 1);
+    return pool;
+}
+
+// Makes the parallel algorithms use e, or the built in thread pool if e is
+// nullptr, and returns the previous replacement. e must outlive its use.
+inline executor* set_default_executor(executor* e) noexcept
+{
+    return internal::default_executor_override.exchange(e);
+}
+
+} // namespace composer
+
+#endif // COMPOSER_THREAD_POOL_HPP
@@ -24,6 +24,13 @@ struct arg_transformer {
     }
 };
 
+// A comparison made with transform_args, e.g. transform_args(key)(less_than),
+// which algorithms can split into its key, c.f.t, and comparison, c.f.f.
+template <typename C>
+concept key_comparison = requires(const C& c) {
+    []<typename T, typename F>(const arg_transformer<T, F>&) {}(c.f);
+};
+
 template <typename T>
 constexpr auto transformation(T&& t)
 {
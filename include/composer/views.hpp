@@ -0,0 +1,239 @@
+#ifndef COMPOSER_VIEWS_HPP
+#define COMPOSER_VIEWS_HPP
+
+#include "composable_function.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace composer {
+
+namespace internal {
+
+// The stages of a fused view push each element into the next stage, and
+// return false when no more elements are wanted.
+
+template <typename P>
+struct filter_stage {
+    [[no_unique_address]] P p;
+
+    template <typename In>
+    using output_t = In;
+
+    template <typename Next, typename T>
+    constexpr bool push(Next&& next, T&& t) const
+    {
+        if (!std::invoke(p, std::as_const(t))) {
+            return true;
+        }
+        return std::forward<Next>(next)(std::forward<T>(t));
+    }
+};
+
+template <typename F>
+struct transform_stage {
+    [[no_unique_address]] F f;
+
+    template <typename In>
+    using output_t = std::invoke_result_t<const F&, In>;
+
+    template <typename Next, typename T>
+    constexpr bool push(Next&& next, T&& t) const
+    {
+        return std::forward<Next>(next)(std::invoke(f, std::forward<T>(t)));
+    }
+};
+
+template <typename P>
+struct take_while_stage {
+    [[no_unique_address]] P p;
+
+    template <typename In>
+    using output_t = In;
+
+    template <typename Next, typename T>
+    constexpr bool push(Next&& next, T&& t) const
+    {
+        if (!std::invoke(p, std::as_const(t))) {
+            return false;
+        }
+        return std::forward<Next>(next)(std::forward<T>(t));
+    }
+};
+
+template <typename In, typename... Stages>
+struct stage_output {
+    using type = In;
+};
+
+template <typename In, typename Stage, typename... Stages>
+struct stage_output<In, Stage, Stages...>
+    : stage_output<typename Stage::template output_t<In>, Stages...> {};
+
+template <typename R, typename... Stages>
+struct fused_view {
+    using element_type =
+        typename stage_output<std::ranges::range_reference_t<R>,
+                              Stages...>::type;
+
+    R range;
+    [[no_unique_address]] std::tuple<Stages...> stages;
+
+    template <typename Self, typename Sink>
+    constexpr void run(this Self& self, Sink&& sink)
+    {
+        for (auto&& e : self.range) {
+            if (!self.template push<0>(sink, std::forward<decltype(e)>(e))) {
+                return;
+            }
+        }
+    }
+
+private:
+    template <std::size_t I, typename Sink, typename T>
+    constexpr bool push(Sink& sink, T&& t) const
+    {
+        if constexpr (I == sizeof...(Stages)) {
+            return sink(std::forward<T>(t));
+        } else {
+            return std::get<I>(stages).push(
+                [this, &sink]<typename U>(U&& u) {
+                    return push<I + 1>(sink, std::forward<U>(u));
+                },
+                std::forward<T>(t));
+        }
+    }
+};
+
+template <typename>
+inline constexpr bool is_fused_view = false;
+
+template <typename R, typename... Stages>
+inline constexpr bool is_fused_view<fused_view<R, Stages...>> = true;
+
+template <typename T>
+concept fusable = is_fused_view<std::remove_cvref_t<T>>
+               || std::ranges::viewable_range<T>;
+
+template <fusable T>
+constexpr decltype(auto) make_fused(T&& t)
+{
+    if constexpr (is_fused_view<std::remove_cvref_t<T>>) {
+        return std::forward<T>(t);
+    } else {
+        return fused_view<std::views::all_t<T>>{ std::views::all(
+                                                     std::forward<T>(t)),
+                                                 {} };
+    }
+}
+
+template <typename V, typename Stage>
+constexpr auto append_stage(V&& v, Stage&& stage)
+{
+    return [&]<typename R, typename... Stages>(
+               std::type_identity<fused_view<R, Stages...>>)
+               -> fused_view<R, Stages..., std::remove_cvref_t<Stage>> {
+        return { std::forward_like<V>(v.range),
+                 std::tuple_cat(std::forward_like<V>(v.stages),
+                                std::tuple<std::remove_cvref_t<Stage>>(
+                                    std::forward<Stage>(stage))) };
+    }(std::type_identity<std::remove_cvref_t<V>>{});
+}
+
+template <typename Stage>
+struct view_stage {
+    static constexpr bool is_nodiscard = true;
+    [[no_unique_address]] Stage stage;
+
+    template <typename Self, fusable T>
+    constexpr auto operator()(this Self&& self, T&& t)
+    {
+        return append_stage(make_fused(std::forward<T>(t)),
+                            std::forward_like<Self>(self.stage));
+    }
+};
+
+template <template <typename> class Stage>
+inline constexpr auto make_view_stage = []<typename F>(F&& f) {
+    return make_composable_function(
+        view_stage<Stage<std::remove_cvref_t<F>>>{ { std::forward<F>(f) } });
+};
+
+template <typename T>
+using fused_element_t = typename std::remove_cvref_t<decltype(make_fused(
+    std::declval<T>()))>::element_type;
+
+} // namespace internal
+
+namespace views {
+
+inline constexpr auto filter = make_composable_function(
+    nodiscard{ internal::make_view_stage<internal::filter_stage> });
+
+inline constexpr auto transform = make_composable_function(
+    nodiscard{ internal::make_view_stage<internal::transform_stage> });
+
+inline constexpr auto take_while = make_composable_function(
+    nodiscard{ internal::make_view_stage<internal::take_while_stage> });
+
+inline constexpr auto sum = make_composable_function(
+    nodiscard{ []<internal::fusable T>(T&& t) {
+        auto&& v = internal::make_fused(std::forward<T>(t));
+        std::remove_cvref_t<internal::fused_element_t<T>> acc{};
+        v.run([&acc]<typename U>(U&& u) {
+            acc += std::forward<U>(u);
+            return true;
+        });
+        return acc;
+    } });
+
+inline constexpr auto count = make_composable_function(
+    nodiscard{ []<internal::fusable T>(T&& t) {
+        auto&& v = internal::make_fused(std::forward<T>(t));
+        std::ptrdiff_t n = 0;
+        v.run([&n](auto&&) {
+            ++n;
+            return true;
+        });
+        return n;
+    } });
+
+inline constexpr auto for_each = make_composable_function(
+    nodiscard{ []<typename F>(F&& f) {
+        return make_composable_function(
+            [f = std::forward<F>(f)]<internal::fusable T>(T&& t) {
+                auto&& v = internal::make_fused(std::forward<T>(t));
+                v.run([&f]<typename U>(U&& u) {
+                    std::invoke(f, std::forward<U>(u));
+                    return true;
+                });
+            });
+    } });
+
+inline constexpr auto fold_left = make_composable_function(
+    nodiscard{ []<typename I, typename F>(I&& init, F&& f) {
+        return make_composable_function(
+            nodiscard{ [init = std::forward<I>(init), f = std::forward<F>(f)]<
+                           internal::fusable T>(T&& t) {
+                using element = internal::fused_element_t<T>;
+                using result = std::decay_t<
+                    std::invoke_result_t<const F&, const I&, element>>;
+                auto&& v = internal::make_fused(std::forward<T>(t));
+                result acc = init;
+                v.run([&acc, &f]<typename U>(U&& u) {
+                    acc = std::invoke(f, std::move(acc), std::forward<U>(u));
+                    return true;
+                });
+                return acc;
+            } });
+    } });
+
+} // namespace views
+
+} // namespace composer
+
+#endif // COMPOSER_VIEWS_HPP
@@ -0,0 +1,102 @@
+# Compares the disassembly of every composer_<name> function in OBJECT with
+# the disassembly of handwritten_<name>, and fails if the composer version
+# has more instructions, more calls or more stack accesses.
+#
+# cmake -D OBJDUMP=<objdump> -D OBJECT=<object file> -P check_codegen.cmake
+
+foreach (var OBJDUMP OBJECT)
+    if (NOT ${var})
+        message(FATAL_ERROR "${var} must be set")
+    endif()
+endforeach()
+
+execute_process(
+        COMMAND ${OBJDUMP} -d -r --no-show-raw-insn ${OBJECT}
+        OUTPUT_VARIABLE disassembly
+        ERROR_VARIABLE error
+        RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} failed: ${error}")
+endif()
+
+string(REPLACE ";" "\;" disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+
+# Out of line parts split off by the optimizer, like composer_x.cold or
+# composer_x.part.0, are accounted to the function they were split from.
+set(function "")
+set(functions "")
+set(previous_mnemonic "")
+foreach (line IN LISTS lines)
+    if (line MATCHES "^[0-9a-f]+ <([A-Za-z_][A-Za-z_0-9]*)[^>]*>:$")
+        set(function ${CMAKE_MATCH_1})
+        if (NOT DEFINED ${function}_instructions)
+            list(APPEND functions ${function})
+            set(${function}_instructions 0)
+            set(${function}_calls 0)
+            set(${function}_stack 0)
+        endif()
+        set(previous_mnemonic "")
+    elseif (function STREQUAL "")
+        continue()
+    elseif (line MATCHES "R_[A-Z0-9_]+")
+        # A jump to a relocated symbol is a tail call.
+        if (previous_mnemonic MATCHES "^(jmp|jmpq|b)$"
+            AND line MATCHES "R_(X86_64_PLT32|X86_64_PC32|AARCH64_JUMP26)")
+            math(EXPR ${function}_calls "${${function}_calls} + 1")
+        endif()
+    elseif (line MATCHES "^ *[0-9a-f]+:[ \t]+([a-z][a-z0-9.]*)(.*)$")
+        set(mnemonic ${CMAKE_MATCH_1})
+        set(operands "${CMAKE_MATCH_2}")
+        set(previous_mnemonic ${mnemonic})
+        # Alignment padding is not code.
+        if (mnemonic MATCHES "^(nop|data16|cs)" OR line MATCHES "xchg +%ax,%ax")
+            continue()
+        endif()
+        math(EXPR ${function}_instructions
+             "${${function}_instructions} + 1")
+        if (mnemonic MATCHES "^(call|callq|bl|blr)$")
+            math(EXPR ${function}_calls "${${function}_calls} + 1")
+        endif()
+        if (mnemonic MATCHES "^(push|pushq|pop|popq|stp|ldp|enter|leave|leaveq)$"
+            OR operands MATCHES "%[re]?[sb]p([^a-z]|$)"
+            OR operands MATCHES "(^|[^a-z0-9])(sp|x29)([^a-z0-9]|$)")
+            math(EXPR ${function}_stack "${${function}_stack} + 1")
+        endif()
+    endif()
+endforeach()
+
+set(failures "")
+set(checked 0)
+foreach (function IN LISTS functions)
+    if (NOT function MATCHES "^composer_(.*)$")
+        continue()
+    endif()
+    set(name ${CMAKE_MATCH_1})
+    set(reference handwritten_${name})
+    if (NOT DEFINED ${reference}_instructions)
+        list(APPEND failures "${name}: no ${reference}")
+        continue()
+    endif()
+    math(EXPR checked "${checked} + 1")
+    set(report "")
+    foreach (metric instructions calls stack)
+        set(c ${${function}_${metric}})
+        set(h ${${reference}_${metric}})
+        string(APPEND report " ${metric} ${c}/${h}")
+        if (c GREATER h)
+            list(APPEND failures "${name}: ${metric} ${c} > ${h}")
+        endif()
+    endforeach()
+    message(STATUS "${name}:${report}")
+endforeach()
+
+if (checked EQUAL 0)
+    message(FATAL_ERROR "no composer_<name> functions found in ${OBJECT}")
+endif()
+if (failures)
+    list(JOIN failures "\n  " text)
+    message(FATAL_ERROR
+            "composer code is worse than handwritten code:\n  ${text}\n"
+            "Run ${OBJDUMP} -d ${OBJECT} for details")
+endif()
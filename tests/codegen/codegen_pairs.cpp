@@ -0,0 +1,132 @@
+// Pairs of functions, composer_<name> and handwritten_<name>, that must
+// compile to equally good code. check_codegen.cmake compares them in the
+// disassembly of the object file.
+
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/ranges.hpp>
+#include <composer/transform_args.hpp>
+
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace codegen {
+struct numname {
+    int num;
+    std::string_view name;
+};
+} // namespace codegen
+
+using codegen::numname;
+
+extern "C" {
+
+bool composer_self_ref(const numname& n)
+{
+    return (composer::mem_fn(&numname::num)
+            == (&numname::name | composer::ssize))(n);
+}
+
+bool handwritten_self_ref(const numname& n)
+{
+    return n.num == std::ssize(n.name);
+}
+
+bool composer_member_equal(const numname& n, int x)
+{
+    return (&numname::num | composer::equal_to(x))(n);
+}
+
+bool handwritten_member_equal(const numname& n, int x)
+{
+    return n.num == x;
+}
+
+bool composer_by_num_less(const numname& lh, const numname& rh)
+{
+    constexpr auto by_num = composer::transform_args(&numname::num);
+    return by_num(composer::less_than)(lh, rh);
+}
+
+bool handwritten_by_num_less(const numname& lh, const numname& rh)
+{
+    return lh.num < rh.num;
+}
+
+bool composer_range_check(const numname& n)
+{
+    constexpr auto in_range = (&numname::num | composer::greater_than(0))
+                           && (&numname::num | composer::less_than(10));
+    return in_range(n);
+}
+
+bool handwritten_range_check(const numname& n)
+{
+    return n.num > 0 && n.num < 10;
+}
+
+int composer_arithmetic(int x)
+{
+    constexpr auto f = composer::identity | composer::plus(1)
+                     | composer::multiplies(2) | composer::minus(3);
+    return f(x);
+}
+
+int handwritten_arithmetic(int x)
+{
+    return (x + 1) * 2 - 3;
+}
+
+const numname* composer_find_if(const numname* first, std::size_t n, int x)
+{
+    return std::to_address(composer::find_if(
+        std::span(first, n), &numname::num | composer::equal_to(x)));
+}
+
+const numname* handwritten_find_if(const numname* first, std::size_t n, int x)
+{
+    return std::to_address(std::ranges::find_if(
+        std::span(first, n), [x](const numname& e) { return e.num == x; }));
+}
+
+std::ptrdiff_t composer_count_if(const numname* first, std::size_t n, int x)
+{
+    return std::span(first, n)
+         | composer::count_if(&numname::num | composer::greater_than(x));
+}
+
+std::ptrdiff_t
+handwritten_count_if(const numname* first, std::size_t n, int x)
+{
+    return std::ranges::count_if(std::span(first, n),
+                                 [x](const numname& e) { return e.num > x; });
+}
+
+bool composer_is_sorted(const numname* first, std::size_t n)
+{
+    constexpr auto by_num = composer::transform_args(&numname::num);
+    return composer::is_sorted(std::span(first, n),
+                               by_num(composer::less_than));
+}
+
+bool handwritten_is_sorted(const numname* first, std::size_t n)
+{
+    return std::ranges::is_sorted(
+        std::span(first, n),
+        [](const numname& lh, const numname& rh) { return lh.num < rh.num; });
+}
+
+const numname* composer_lower_bound(const numname* first, std::size_t n, int x)
+{
+    return std::to_address(composer::lower_bound(
+        std::span(first, n), x, composer::less_than, &numname::num));
+}
+
+const numname*
+handwritten_lower_bound(const numname* first, std::size_t n, int x)
+{
+    return std::to_address(std::ranges::lower_bound(
+        std::span(first, n), x, std::ranges::less{}, &numname::num));
+}
+}
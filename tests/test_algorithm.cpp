@@ -11,6 +11,12 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace {
 struct numname {
@@ -42,6 +48,17 @@ constexpr auto dup(T&& t)
 {
     return std::forward<T>(t);
 }
+
+// A key that is computed, and counts how many times it is.
+struct counted_name {
+    int* calls;
+
+    std::string operator()(const numname& n) const
+    {
+        ++*calls;
+        return std::string(n.name);
+    }
+};
 } // namespace
 
 SCENARIO("all_of is back binding")
@@ -2661,6 +2678,86 @@ SCENARIO("equal_range")
     }
 }
 
+SCENARIO("lower_bound_batch")
+{
+    static constexpr std::array queries{ 5, 0, 3, 9, 3 };
+
+    SECTION("lower_bound_batch called with a range, queries, an output, a "
+            "predicate and a projection writes the lower bound of each query")
+    {
+        std::vector<const numname*> found;
+        composer::lower_bound_batch(values,
+                                    queries,
+                                    std::back_inserter(found),
+                                    composer::less_than,
+                                    &numname::num);
+        std::vector<const numname*> expected;
+        for (int query : queries) {
+            expected.push_back(std::ranges::lower_bound(
+                values, query, std::ranges::less{}, &numname::num));
+        }
+        REQUIRE(found == expected);
+    }
+    SECTION("lower_bound_batch gives the same results as lower_bound for "
+            "many queries and a long range")
+    {
+        std::vector<int> haystack;
+        for (int i = 0; i != 5000; ++i) {
+            haystack.push_back(i / 2 * 3);
+        }
+        std::vector<int> many;
+        for (int i = 0; i != 1000; ++i) {
+            many.push_back(i * 7919 % 8000 - 10);
+        }
+        std::vector<std::vector<int>::iterator> found(many.size());
+        const auto [in, out]
+            = composer::lower_bound_batch(haystack, many, found.begin());
+        REQUIRE(in == many.end());
+        REQUIRE(out == found.end());
+        for (std::size_t i = 0; i != many.size(); ++i) {
+            REQUIRE(found[i] == composer::lower_bound(haystack, many[i]));
+        }
+    }
+    SECTION("lower_bound_batch called with an output, a predicate and a "
+            "projection is callable with a range and queries")
+    {
+        std::vector<const numname*> found;
+        const auto find_nums = composer::lower_bound_batch(
+            std::back_inserter(found), composer::less_than, &numname::num);
+        static constexpr std::array four{ 4 };
+        find_nums(values, four);
+        REQUIRE(found == std::vector{ values.begin() + 3 });
+    }
+    SECTION("the lower bound of a query after all elements is the end")
+    {
+        static constexpr std::array<numname, 0> none{};
+        std::vector<const numname*> found;
+        composer::lower_bound_batch(none,
+                                    queries,
+                                    std::back_inserter(found),
+                                    composer::less_than,
+                                    &numname::num);
+        REQUIRE(found.size() == queries.size());
+        static constexpr std::array hundred{ 100 };
+        composer::lower_bound_batch(values,
+                                    hundred,
+                                    std::back_inserter(found),
+                                    composer::less_than,
+                                    &numname::num);
+        REQUIRE(found.back() == values.end());
+    }
+    SECTION("lower_bound_batch is not allowed on an r-value range")
+    {
+        std::vector<const numname*> found;
+        STATIC_REQUIRE(returns_callable(composer::lower_bound_batch,
+                                        dup(values),
+                                        queries,
+                                        std::back_inserter(found),
+                                        composer::less_than,
+                                        &numname::num));
+    }
+}
+
 SCENARIO("merge")
 {
     static constexpr std::array odd{ 1, 3, 5 };
@@ -2920,6 +3017,81 @@ SCENARIO("set_union")
     }
 }
 
+SCENARIO("set operations on ranges of very different sizes")
+{
+    // Keys with duplicates, and a sequence number to tell equal keys apart.
+    const auto entries = [](int count, int step, int seq) {
+        std::vector<std::pair<int, int>> v;
+        for (int i = 0; i != count; ++i) {
+            v.emplace_back(i / 3 * step, seq + i);
+        }
+        return v;
+    };
+    const auto large = entries(30000, 2, 0);
+    const auto small = entries(100, 301, 100000);
+    const auto key = &std::pair<int, int>::first;
+    std::size_t comparisons = 0;
+    const auto counted_less = [&](int a, int b) {
+        ++comparisons;
+        return a < b;
+    };
+    // Calls algorithm with the larger range first and with it second, and
+    // returns what it wrote.
+    const auto both_ways = [&](const auto& algorithm, auto comp) {
+        std::vector<std::pair<int, int>> output;
+        algorithm(large, small, std::back_inserter(output), comp, key, key);
+        algorithm(small, large, std::back_inserter(output), comp, key, key);
+        return output;
+    };
+
+    SECTION("set_intersection copies the same elements as "
+            "ranges::set_intersection, with fewer comparisons")
+    {
+        REQUIRE(both_ways(composer::set_intersection, counted_less)
+                == both_ways(std::ranges::set_intersection, std::less{}));
+        REQUIRE(comparisons < 5000);
+    }
+    SECTION("set_difference copies the same elements as "
+            "ranges::set_difference, with fewer comparisons")
+    {
+        REQUIRE(both_ways(composer::set_difference, counted_less)
+                == both_ways(std::ranges::set_difference, std::less{}));
+        REQUIRE(comparisons < 5000);
+    }
+    SECTION("merge is stable, like ranges::merge, with fewer comparisons")
+    {
+        REQUIRE(both_ways(composer::merge, counted_less)
+                == both_ways(std::ranges::merge, std::less{}));
+        REQUIRE(comparisons < 5000);
+    }
+    SECTION("includes gallops through the including range")
+    {
+        REQUIRE(composer::includes(large, small, counted_less, key, key)
+                == std::ranges::includes(large, small, {}, key, key));
+        auto included = entries(100, 302, 0);
+        REQUIRE(composer::includes(large, included, counted_less, key, key));
+        REQUIRE(comparisons < 5000);
+        REQUIRE_FALSE(composer::includes(small, large, counted_less, key, key));
+        REQUIRE_FALSE(composer::includes(
+            entries(3, 2, 0), entries(4, 2, 0), counted_less, key, key));
+    }
+    SECTION("and in constant evaluation")
+    {
+        constexpr auto intersection = [] {
+            std::array<int, 64> many{};
+            for (std::size_t i = 0; i != many.size(); ++i) {
+                many[i] = static_cast<int>(i);
+            }
+            const std::array few{ 3, 17 };
+            std::array<int, 2> out{};
+            composer::set_intersection(
+                many, few, out.begin(), composer::less_than);
+            return out;
+        }();
+        STATIC_REQUIRE(intersection == std::array{ 3, 17 });
+    }
+}
+
 SCENARIO("is_heap")
 {
     static constexpr std::array<numname, 6> nonheap{ { { 1, "one" },
@@ -3761,3 +3933,276 @@ SCENARIO("nth_element")
         STATIC_REQUIRE_FALSE(can_pipe(values, third_by_name));
     }
 }
+
+SCENARIO("top_k")
+{
+    SECTION("top_k returns the first k elements in the order of comp")
+    {
+        const auto top = composer::top_k(
+            values,
+            3,
+            composer::transform_args(&numname::num, composer::greater_than));
+        REQUIRE(top.size() == 3);
+        REQUIRE(top[0].name == "five");
+        REQUIRE(top[1].name == "four");
+        REQUIRE(top[2].name == "three");
+        REQUIRE(composer::top_k(values, 2, composer::less_than, &numname::name)
+                    .back()
+                    .name
+                == "four");
+    }
+    SECTION("top_k with fewer than k elements returns all of them sorted")
+    {
+        REQUIRE(composer::top_k(std::vector{ 3, 1, 2 }, 10)
+                == std::vector{ 1, 2, 3 });
+        REQUIRE(composer::top_k(std::vector{ 3, 1, 2 }, 0).empty());
+    }
+    SECTION("top_k reads single pass ranges once")
+    {
+        std::istringstream is("5 8 1 9 3 9 2 7");
+        const auto top = composer::top_k(
+            std::views::istream<int>(is), 3, composer::greater_than);
+        REQUIRE(top == std::vector{ 9, 9, 8 });
+    }
+    SECTION("top_k is pipeable")
+    {
+        const auto squares = std::views::iota(-50, 50)
+                           | std::views::transform([](int i) { return i * i; });
+        REQUIRE((squares | composer::top_k(4, composer::less_than))
+                == std::vector{ 0, 1, 1, 4 });
+        const auto largest = composer::top_k(2, composer::greater_than);
+        REQUIRE((squares | largest) == std::vector{ 2500, 2401 });
+    }
+    SECTION("top_k can be evaluated at compile time")
+    {
+        STATIC_REQUIRE(
+            composer::top_k(values, 1, std::ranges::less{}, &numname::num)[0]
+                .num
+            == 1);
+    }
+}
+
+SCENARIO("sort_by_key computes each key once")
+{
+    SECTION("the range is sorted by the keys")
+    {
+        auto local_values = values;
+        int calls = 0;
+        const auto i = composer::sort_by_key(local_values,
+                                             counted_name{ &calls },
+                                             composer::less_than);
+        REQUIRE(i == local_values.end());
+        REQUIRE(calls == 5);
+        REQUIRE(local_values[0].name == "five");
+        REQUIRE(local_values[1].name == "four");
+        REQUIRE(local_values[2].name == "one");
+        REQUIRE(local_values[3].name == "three");
+        REQUIRE(local_values[4].name == "two");
+    }
+    SECTION("a transform_args comparison is split into key and comparison")
+    {
+        auto local_values = values;
+        int calls = 0;
+        composer::sort_by_key(
+            local_values,
+            composer::transform_args(counted_name{ &calls },
+                                     composer::greater_than));
+        REQUIRE(calls == 5);
+        REQUIRE(local_values[0].name == "two");
+        REQUIRE(local_values[4].name == "five");
+    }
+    SECTION("sort_by_key with a key is callable with a range")
+    {
+        auto local_values = values;
+        auto by_name = composer::sort_by_key(&numname::name);
+        by_name(local_values);
+        REQUIRE(local_values[0].num == 5);
+        STATIC_REQUIRE_FALSE(can_pipe(local_values, by_name));
+    }
+    SECTION("long ranges are permuted correctly")
+    {
+        std::vector<int> v(1000);
+        for (std::size_t i = 0; i != v.size(); ++i) {
+            v[i] = static_cast<int>((i * 7919) % 1000);
+        }
+        int calls = 0;
+        composer::sort_by_key(v, [&calls](int x) {
+            ++calls;
+            return -x;
+        });
+        REQUIRE(calls == 1000);
+        REQUIRE(std::ranges::is_sorted(v, std::ranges::greater{}));
+        REQUIRE(v.front() == 999);
+        REQUIRE(v.back() == 0);
+    }
+    SECTION("sort_by_key can be evaluated at compile time")
+    {
+        constexpr auto sorted = [] {
+            auto local_values = values;
+            composer::sort_by_key(local_values,
+                                  [](const numname& n) { return -n.num; });
+            return local_values;
+        }();
+        STATIC_REQUIRE(sorted[0].num == 5);
+        STATIC_REQUIRE(sorted[4].num == 1);
+    }
+}
+
+SCENARIO("stable_sort_by_key keeps the order of equal keys")
+{
+    auto local_values = values;
+    int calls = 0;
+    const auto length = [&calls](const numname& n) {
+        ++calls;
+        return n.name.size();
+    };
+    composer::stable_sort_by_key(local_values, length);
+    REQUIRE(calls == 5);
+    REQUIRE(local_values[0].name == "one");
+    REQUIRE(local_values[1].name == "two");
+    REQUIRE(local_values[2].name == "four");
+    REQUIRE(local_values[3].name == "five");
+    REQUIRE(local_values[4].name == "three");
+}
+
+SCENARIO("is_sorted_by_key computes each key once")
+{
+    int calls = 0;
+    REQUIRE(composer::is_sorted_by_key(
+        values, [&calls](const numname& n) { return ++calls, n.num; }));
+    REQUIRE(calls == 5);
+    calls = 0;
+    REQUIRE_FALSE(composer::is_sorted_by_key(values, counted_name{ &calls }));
+    REQUIRE(calls == 3);
+    REQUIRE(values
+            | composer::is_sorted_by_key(composer::transform_args(
+                &numname::num, composer::less_than)));
+    STATIC_REQUIRE(composer::is_sorted_by_key(
+        values, [](const numname& n) { return n.num * 2; }));
+    SECTION("is_sorted_until_by_key returns the first element out of order")
+    {
+        calls = 0;
+        const auto i
+            = composer::is_sorted_until_by_key(values, counted_name{ &calls });
+        REQUIRE(i == values.begin() + 2);
+        REQUIRE(composer::is_sorted_until_by_key(
+                    values, counted_name{ &calls }, composer::greater_than)
+                == values.begin() + 1);
+    }
+}
+
+SCENARIO("adjacent_find_by_key computes each key once")
+{
+    int calls = 0;
+    const auto length = [&calls](const numname& n) {
+        ++calls;
+        return n.name.size();
+    };
+    REQUIRE(composer::adjacent_find_by_key(values, length) == values.begin());
+    REQUIRE(calls == 2);
+    calls = 0;
+    REQUIRE(composer::adjacent_find_by_key(values, length, composer::less_than)
+            == values.begin() + 1);
+    REQUIRE(calls == 3);
+    calls = 0;
+    const auto odd = [&calls](const numname& n) {
+        ++calls;
+        return n.num % 2;
+    };
+    REQUIRE(composer::adjacent_find_by_key(values, odd) == values.end());
+    REQUIRE(calls == 5);
+    REQUIRE((values | composer::adjacent_find_by_key(&numname::num))
+            == values.end());
+}
+
+SCENARIO("a bound byte pattern is searched for with a precomputed table")
+{
+    using namespace std::string_view_literals;
+    static constexpr auto text = "abracadabra, abracadabra"sv;
+    SECTION("search finds the first occurrence")
+    {
+        constexpr auto search_abra = composer::search("abra"sv);
+        STATIC_REQUIRE(search_abra(text).begin() == text.begin());
+        STATIC_REQUIRE(composer::search("cad"sv)(text).begin()
+                       == text.begin() + 4);
+        REQUIRE((text | composer::search("dabra,"sv)).begin()
+                == text.begin() + 6);
+        REQUIRE((text | composer::search("dabra,"sv)).size() == 6);
+        REQUIRE((text | composer::search("abrax"sv)).begin() == text.end());
+        REQUIRE((text | composer::search("abrax"sv)).empty());
+        REQUIRE((text | composer::search(""sv)).begin() == text.begin());
+        REQUIRE((text | composer::search(""sv)).empty());
+        REQUIRE(("ab"sv | composer::search("abc"sv)).begin() == "ab"sv.end());
+    }
+    SECTION("find_end finds the last occurrence")
+    {
+        constexpr auto find_end_abra = composer::find_end("abra"sv);
+        STATIC_REQUIRE(find_end_abra(text).begin() == text.begin() + 20);
+        REQUIRE(find_end_abra(text).end() == text.end());
+        REQUIRE((text | composer::find_end("a, a"sv)).begin()
+                == text.begin() + 10);
+        REQUIRE((text | composer::find_end("abrax"sv)).begin() == text.end());
+        REQUIRE((text | composer::find_end(""sv)).begin() == text.end());
+        REQUIRE((text | composer::find_end(text)).begin() == text.begin());
+    }
+    SECTION("contains_subrange tells if there is an occurrence")
+    {
+        STATIC_REQUIRE(composer::contains_subrange("cadab"sv)(text));
+        REQUIRE(text | composer::contains_subrange(", "sv));
+        REQUIRE_FALSE(text | composer::contains_subrange("abab"sv));
+        REQUIRE(text | composer::contains_subrange(""sv));
+    }
+    SECTION("find_first_of finds the first byte in the set")
+    {
+        constexpr auto find_punct = composer::find_first_of(",;."sv);
+        STATIC_REQUIRE(find_punct(text) == text.begin() + 11);
+        REQUIRE((text | composer::find_first_of("xyz"sv)) == text.end());
+        REQUIRE((text | composer::find_first_of(""sv)) == text.end());
+    }
+    SECTION("the results are those of the unbound algorithms")
+    {
+        std::vector<unsigned char> bytes;
+        for (unsigned i = 0; i != 2000; ++i) {
+            bytes.push_back(static_cast<unsigned char>(i * i % 7 * 40));
+        }
+        const auto same = [](const auto& a, const auto& b) {
+            return a.begin() == b.begin() && a.end() == b.end();
+        };
+        for (std::size_t length = 0; length != 6; ++length) {
+            const std::vector needle(bytes.begin() + 100,
+                                     bytes.begin() + 100 + length * 3);
+            REQUIRE(same(composer::search(needle)(bytes),
+                         std::ranges::search(bytes, needle)));
+            REQUIRE(same(composer::find_end(needle)(bytes),
+                         std::ranges::find_end(bytes, needle)));
+            REQUIRE(composer::contains_subrange(needle)(bytes)
+                    == std::ranges::contains_subrange(bytes, needle));
+            REQUIRE(composer::find_first_of(needle)(bytes)
+                    == std::ranges::find_first_of(bytes, needle));
+        }
+    }
+    SECTION("needles longer than the largest shift are found")
+    {
+        static constexpr auto bytes = [] {
+            std::array<unsigned char, 1000> a{};
+            std::uint32_t seed = 1;
+            for (auto& byte : a) {
+                seed = seed * 1664525 + 1013904223;
+                byte = static_cast<unsigned char>(seed >> 24);
+            }
+            return a;
+        }();
+        constexpr std::span needle(bytes.begin() + 500, 400);
+        STATIC_REQUIRE(composer::search(needle)(bytes).begin()
+                       == bytes.begin() + 500);
+        STATIC_REQUIRE(composer::find_end(needle)(bytes).begin()
+                       == bytes.begin() + 500);
+        STATIC_REQUIRE(composer::contains_subrange(needle)(bytes));
+        STATIC_REQUIRE_FALSE(
+            composer::contains_subrange(needle)(std::span(bytes).first(899)));
+    }
+    SECTION("the bound table is small enough to copy")
+    {
+        STATIC_REQUIRE(sizeof(composer::search("abra"sv)) < 512);
+    }
+}
@@ -5,6 +5,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <memory>
+#include <tuple>
 
 TEST_CASE("a back bound function is called with all provided arguments")
 {
@@ -38,6 +39,43 @@ TEST_CASE("a back bound function can be called with fewer than arity "
     REQUIRE(dec(3) == 2);
 }
 
+namespace {
+// Binds the square of its bound argument, that it would otherwise compute
+// on every call, and counts the squarings.
+struct minus_square {
+    int* squarings;
+
+    struct square {
+        int value;
+    };
+
+    int operator()(int a, int b) const { return a - (++*squarings, b * b); }
+
+    int operator()(int a, square b) const { return a - b.value; }
+
+    std::tuple<square> prepare_back(std::tuple<int>&& as) const
+    {
+        ++*squarings;
+        return { { std::get<0>(as) * std::get<0>(as) } };
+    }
+};
+} // namespace
+
+TEST_CASE("a back bound function binds what its prepare_back returns for "
+          "the bound arguments")
+{
+    int squarings = 0;
+    const auto f = composer::make_composable_function<composer::back_binding>(
+        minus_square{ &squarings });
+    REQUIRE(f(10, 3) == 1);
+    REQUIRE(squarings == 1);
+    const auto f3 = f(3);
+    REQUIRE(squarings == 2);
+    REQUIRE(f3(10) == 1);
+    REQUIRE(f3(20) == 11);
+    REQUIRE(squarings == 2);
+}
+
 namespace {
 template <typename, typename>
 struct same_cv : std::false_type {};
@@ -93,3 +93,90 @@ TEST_CASE("a piped expressions calls the right hand side with the result of "
     auto sub_to_str = minus | to_string;
     REQUIRE(sub_to_str(5, 3) == "2");
 }
+
+TEST_CASE("a chain of pipes is stored as one flat pipeline")
+{
+    constexpr auto inc = composer::make_composable_function(
+        [](int x) { return x + 1; });
+    constexpr auto twice = composer::make_composable_function(
+        [](int x) { return x * 2; });
+    constexpr auto f = inc | twice | inc | twice;
+    using inc_t = std::remove_cvref_t<decltype(inc)>;
+    using twice_t = std::remove_cvref_t<decltype(twice)>;
+    STATIC_REQUIRE(
+        std::is_same_v<
+            std::remove_cvref_t<decltype(f)>,
+            composer::composable_function<composer::internal::pipeline<
+                decltype(inc.f),
+                twice_t,
+                inc_t,
+                twice_t>>>);
+    STATIC_REQUIRE(f(1) == 10);
+    REQUIRE(f(1) == 10);
+}
+
+TEST_CASE("piping into a composed function splices its stages into the "
+          "pipeline")
+{
+    constexpr auto inc = composer::make_composable_function(
+        [](int x) { return x + 1; });
+    constexpr auto twice = composer::make_composable_function(
+        [](int x) { return x * 2; });
+    constexpr auto lh = inc | twice;
+    constexpr auto rh = twice | inc;
+    constexpr auto f = lh | rh;
+    STATIC_REQUIRE(
+        std::tuple_size_v<std::remove_cvref_t<decltype(f.f.fs)>> == 4);
+    STATIC_REQUIRE(f(1) == 9);
+    REQUIRE(f(1) == 9);
+}
+
+TEST_CASE("a pipeline is nodiscard if its last stage is nodiscard")
+{
+    constexpr auto plain = composer::make_composable_function(
+        [](int x) { return x + 1; });
+    constexpr auto nd = composer::make_composable_function(
+        composer::nodiscard{ [](int x) { return x * 2; } });
+    STATIC_REQUIRE(decltype(plain | plain | nd)::is_nodiscard);
+    STATIC_REQUIRE_FALSE(decltype(nd | nd | plain)::is_nodiscard);
+}
+
+TEST_CASE("a pipeline calls every stage with the qualifiers of the pipeline")
+{
+    struct stage {
+        constexpr int operator()(int x) const& { return x + 1; }
+
+        constexpr int operator()(int x) && { return x + 100; }
+    };
+
+    auto f = composer::make_composable_function(stage{})
+           | composer::make_composable_function(stage{})
+           | composer::make_composable_function(stage{});
+    REQUIRE(f(0) == 3);
+    REQUIRE(std::move(f)(0) == 300);
+}
+
+TEST_CASE("a pipeline passes each result on to the next stage as returned")
+{
+    struct pinned {
+        int value;
+
+        explicit pinned(int v) : value(v) {}
+
+        pinned(pinned&&) = delete;
+    };
+
+    const auto make = composer::make_composable_function(
+        [](int x) { return pinned(x); });
+    const auto twice = [](pinned&& p) { return pinned(p.value * 2); };
+    const auto value = [](const pinned& p) -> const int& { return p.value; };
+    STATIC_REQUIRE(std::is_same_v<decltype((make | twice)(1)), pinned>);
+    REQUIRE((make | twice)(1).value == 2);
+    REQUIRE((make | twice | twice | value)(1) == 4);
+
+    int x = 1;
+    const auto ref = composer::make_composable_function(
+        [](int& i) -> int& { return i; });
+    (ref | ref | ref | ref)(x) = 5;
+    REQUIRE(x == 5);
+}
@@ -0,0 +1,315 @@
+#include <composer/algorithm.hpp>
+#include <composer/execution.hpp>
+#include <composer/functional.hpp>
+#include <composer/thread_pool.hpp>
+#include <composer/transform_args.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+struct numname {
+    int num;
+    std::string_view name;
+};
+
+// A threshold of 2 makes the algorithms run in parallel even for small
+// ranges.
+constexpr composer::parallel_policy par_always{ .threshold = 2 };
+
+// Runs tasks as they are submitted, and counts them, which tells whether an
+// algorithm took its parallel path.
+class counting_executor final : public composer::executor {
+public:
+    std::size_t concurrency() const noexcept override { return 3; }
+
+    void submit(composer::function<void()> task) override
+    {
+        ++submitted;
+        task();
+    }
+
+    bool try_run_one() override { return false; }
+
+    std::size_t submitted = 0;
+};
+
+std::vector<int> iota(int n)
+{
+    std::vector<int> v(static_cast<std::size_t>(n));
+    std::iota(v.begin(), v.end(), 0);
+    return v;
+}
+
+// Values in [0, range), in an order that depends on seed.
+std::vector<int> scrambled(std::size_t n, int range, std::uint32_t seed = 1)
+{
+    std::vector<int> v(n);
+    for (auto& i : v) {
+        seed = seed * 1664525 + 1013904223;
+        i = static_cast<int>((seed >> 8) % static_cast<std::uint32_t>(range));
+    }
+    return v;
+}
+} // namespace
+
+TEST_CASE("algorithms accept an execution policy first or bound")
+{
+    constexpr numname values[]{
+        { 3, "three" }, { 1, "one" }, { 4, "four" }, { 2, "two" }
+    };
+    constexpr auto by_num = composer::transform_args(&numname::num);
+    STATIC_REQUIRE(composer::find_if(composer::seq,
+                                     values,
+                                     &numname::num | composer::equal_to(4))
+                   == values + 2);
+    STATIC_REQUIRE((values
+                    | composer::find_if(composer::par,
+                                        &numname::num | composer::equal_to(4)))
+                   == values + 2);
+    STATIC_REQUIRE(composer::is_sorted(composer::par_unseq,
+                                       values,
+                                       by_num(composer::greater_than))
+                   == false);
+    STATIC_REQUIRE(returns_callable(composer::sort, composer::par));
+
+    std::vector<numname> v(std::begin(values), std::end(values));
+    composer::sort(composer::par, by_num(composer::less_than))(v);
+    REQUIRE(composer::is_sorted(v, by_num(composer::less_than)));
+    composer::sort(composer::par, v, by_num(composer::greater_than));
+    REQUIRE(composer::is_sorted(v, by_num(composer::greater_than)));
+}
+
+TEST_CASE("parallel searches find the first match")
+{
+    auto v = iota(100000);
+    v[70000] = -1;
+    v[90000] = -1;
+    REQUIRE(composer::find(par_always, v, -1) == v.begin() + 70000);
+    REQUIRE((v | composer::find_if(par_always, composer::less_than(0)))
+            == v.begin() + 70000);
+    REQUIRE(composer::find_if_not(par_always, v, composer::less_than(70000))
+            == v.begin() + 70001);
+    REQUIRE(composer::find(par_always, v, -2) == v.end());
+    REQUIRE(composer::contains(par_always, v, -1));
+    REQUIRE(!composer::contains(par_always, v, -2));
+    REQUIRE(composer::any_of(par_always, v, composer::less_than(0)));
+    REQUIRE(!composer::all_of(par_always, v, composer::less_than(0)));
+    REQUIRE(composer::none_of(par_always, v, composer::less_than(-1)));
+    REQUIRE(composer::all_of(par_always, v, composer::less_than(100000)));
+}
+
+TEST_CASE("parallel count gives the same result as serial count")
+{
+    const auto v = iota(100000);
+    const auto odd = composer::identity | composer::modulus(2)
+                   | composer::equal_to(1);
+    REQUIRE(composer::count_if(par_always, v, odd) == 50000);
+    REQUIRE((v | composer::count_if(composer::par_unseq, odd)) == 50000);
+    REQUIRE(composer::count(par_always, v, 17) == 1);
+}
+
+TEST_CASE("parallel modifying algorithms visit every element")
+{
+    auto v = iota(100000);
+    std::atomic<long> sum = 0;
+    composer::for_each(par_always, v, [&sum](int i) { sum += i; });
+    REQUIRE(sum == 100000L * 99999L / 2);
+
+    composer::replace_if(par_always, v, composer::less_than(50000), -1);
+    REQUIRE(composer::count(v, -1) == 50000);
+    composer::replace(par_always, v, -1, 0);
+    REQUIRE(composer::count(v, 0) == 50000);
+    composer::fill(par_always, 3)(v);
+    REQUIRE(composer::count(v, 3) == 100000);
+}
+
+TEST_CASE("parallel min and max elements resolve ties like serial ones")
+{
+    std::vector<int> v(100000, 5);
+    v[30000] = 1;
+    v[60000] = 1;
+    v[40000] = 9;
+    v[80000] = 9;
+    REQUIRE(composer::min_element(par_always, v) == v.begin() + 30000);
+    REQUIRE(composer::max_element(par_always, v) == v.begin() + 40000);
+    const auto [min, max] = composer::minmax_element(par_always, v);
+    REQUIRE(min == v.begin() + 30000);
+    REQUIRE(max == v.begin() + 80000);
+}
+
+TEST_CASE("parallel sort gives the same order as serial sort")
+{
+    for (std::size_t size : { 3, 1000, 100000 }) {
+        auto v = scrambled(size, 1'000'000);
+        auto expected = v;
+        std::ranges::sort(expected);
+        composer::sort(par_always, v);
+        REQUIRE(v == expected);
+
+        std::vector<std::string> strings;
+        for (int i : scrambled(size, 5000)) {
+            strings.push_back(std::to_string(i));
+        }
+        auto expected_strings = strings;
+        std::ranges::sort(expected_strings, std::ranges::greater{});
+        composer::sort(par_always, strings, std::ranges::greater{});
+        REQUIRE(strings == expected_strings);
+    }
+}
+
+TEST_CASE("parallel stable_sort keeps equal elements in order")
+{
+    using entry = std::pair<int, std::size_t>;
+    std::vector<entry> v;
+    for (int i : scrambled(100000, 100)) {
+        v.emplace_back(i, v.size());
+    }
+    auto expected = v;
+    std::ranges::stable_sort(expected, std::ranges::less{}, &entry::first);
+    counting_executor exec;
+    const composer::parallel_policy par_counted{ .threshold = 2,
+                                                 .pool = &exec };
+    SECTION("with radix sorted chunks")
+    {
+        composer::stable_sort(
+            par_counted,
+            v,
+            composer::transform_args(&entry::first, composer::less_than));
+    }
+    SECTION("with comparison sorted chunks")
+    {
+        composer::stable_sort(
+            par_counted, v, [](const entry& a, const entry& b) {
+                return a.first < b.first;
+            });
+    }
+    REQUIRE(exec.submitted > 0);
+    REQUIRE(v == expected);
+}
+
+TEST_CASE("parallel sort with a transform_args comparison runs in parallel")
+{
+    auto v = scrambled(100000, 1'000'000);
+    auto expected = v;
+    std::ranges::sort(expected, std::ranges::greater{});
+    counting_executor exec;
+    const composer::parallel_policy par_counted{ .threshold = 2,
+                                                 .pool = &exec };
+    composer::sort(par_counted,
+                   v,
+                   composer::transform_args(composer::identity,
+                                            composer::greater_than));
+    REQUIRE(exec.submitted > 0);
+    REQUIRE(v == expected);
+}
+
+TEST_CASE("parallel sorts move elements that may throw when moved")
+{
+    // No default constructor, and a move that is not noexcept, so the merge
+    // buffer is filled one element at a time.
+    struct boxed {
+        int value;
+
+        explicit boxed(int v) : value(v) {}
+
+        boxed(const boxed&) = default;
+
+        boxed(boxed&& other) noexcept(false) : value(other.value) {}
+
+        boxed& operator=(const boxed&) = default;
+
+        boxed& operator=(boxed&&) = default;
+
+        auto operator<=>(const boxed&) const = default;
+    };
+
+    std::vector<boxed> v;
+    for (int i : scrambled(100000, 1000)) {
+        v.emplace_back(i);
+    }
+    auto expected = v;
+    std::ranges::sort(expected);
+    auto sorted = v;
+    composer::sort(par_always, sorted);
+    REQUIRE(sorted == expected);
+    const auto nth = v.begin() + 54321;
+    composer::nth_element(par_always, v, nth);
+    REQUIRE(*nth == expected[54321]);
+}
+
+TEST_CASE("parallel nth_element partitions around the nth element")
+{
+    for (int range : { 3, 1000, 1'000'000 }) {
+        const auto original = scrambled(200000, range);
+        auto sorted = original;
+        std::ranges::sort(sorted);
+        for (std::size_t n : { 0, 1, 77777, 100000, 199999, 200000 }) {
+            auto v = original;
+            const auto nth = v.begin() + static_cast<std::ptrdiff_t>(n);
+            REQUIRE(composer::nth_element(par_always, v, nth) == v.end());
+            if (nth != v.end()) {
+                REQUIRE(*nth == sorted[n]);
+                REQUIRE(std::all_of(v.begin(), nth, [&](int i) {
+                    return i <= *nth;
+                }));
+                REQUIRE(std::all_of(nth, v.end(), [&](int i) {
+                    return i >= *nth;
+                }));
+            }
+            std::ranges::sort(v);
+            REQUIRE(v == sorted);
+        }
+    }
+}
+
+TEST_CASE("parallel top_k merges the top k of each chunk")
+{
+    const auto v = scrambled(100000, 1'000'000);
+    auto sorted = v;
+    std::ranges::sort(sorted, std::ranges::greater{});
+    sorted.resize(100);
+    REQUIRE(composer::top_k(par_always, v, 100, composer::greater_than)
+            == sorted);
+    REQUIRE((v | composer::top_k(par_always, 100, composer::greater_than))
+            == sorted);
+    REQUIRE(composer::top_k(par_always, v, 200000).size() == 100000);
+}
+
+TEST_CASE("parallel lower_bound_batch searches for a chunk of queries each")
+{
+    auto haystack = scrambled(100000, 1'000'000);
+    std::ranges::sort(haystack);
+    const auto queries = scrambled(10000, 1'100'000, 7);
+    std::vector<std::vector<int>::iterator> found(queries.size());
+    composer::lower_bound_batch(
+        par_always, haystack, queries, found.begin(), composer::less_than);
+    for (std::size_t i = 0; i != queries.size(); ++i) {
+        REQUIRE(found[i] == std::ranges::lower_bound(haystack, queries[i]));
+    }
+}
+
+TEST_CASE("an exception thrown in a parallel algorithm is rethrown")
+{
+    const auto v = iota(100000);
+    REQUIRE_THROWS_AS(composer::for_each(par_always,
+                                         v,
+                                         [](int i) {
+                                             if (i == 99999) {
+                                                 throw std::runtime_error(
+                                                     "too large");
+                                             }
+                                         }),
+                      std::runtime_error);
+}
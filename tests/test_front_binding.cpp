@@ -4,6 +4,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <tuple>
+
 TEST_CASE("a front bound function is called with all provided arguments")
 {
     constexpr auto minus = composer::front_binding<std::minus<>>{};
@@ -63,6 +65,43 @@ struct check {
 };
 } // namespace
 
+namespace {
+// Binds the square of its bound argument, that it would otherwise compute
+// on every call, and counts the squarings.
+struct square_minus {
+    int* squarings;
+
+    struct square {
+        int value;
+    };
+
+    int operator()(int a, int b) const { return (++*squarings, a * a) - b; }
+
+    int operator()(square a, int b) const { return a.value - b; }
+
+    std::tuple<square> prepare_front(std::tuple<int>&& as) const
+    {
+        ++*squarings;
+        return { { std::get<0>(as) * std::get<0>(as) } };
+    }
+};
+} // namespace
+
+TEST_CASE("a front bound function binds what its prepare_front returns for "
+          "the bound arguments")
+{
+    int squarings = 0;
+    const auto f = composer::make_composable_function<composer::front_binding>(
+        square_minus{ &squarings });
+    REQUIRE(f(3, 1) == 8);
+    REQUIRE(squarings == 1);
+    const auto f3 = f(3);
+    REQUIRE(squarings == 2);
+    REQUIRE(f3(1) == 8);
+    REQUIRE(f3(2) == 7);
+    REQUIRE(squarings == 2);
+}
+
 TEST_CASE("a front bound function and its bound args are called with the same "
           "qualifiers as the function object")
 {
@@ -0,0 +1,166 @@
+#include <composer/algorithm.hpp>
+#include <composer/function.hpp>
+#include <composer/functional.hpp>
+#include <composer/transform_args.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+struct numname {
+    int num;
+    std::string_view name;
+};
+} // namespace
+
+TEST_CASE("a default constructed function is empty and throws when called")
+{
+    composer::function<int(int)> f;
+    REQUIRE(!static_cast<bool>(f));
+    REQUIRE_THROWS_AS(f(1), std::bad_function_call);
+    composer::function<int(int)> g = nullptr;
+    REQUIRE(!static_cast<bool>(g));
+}
+
+TEST_CASE("a function calls the stored callable")
+{
+    composer::function<int(int, int)> f = [](int a, int b) { return a - b; };
+    REQUIRE(static_cast<bool>(f));
+    REQUIRE(f(5, 2) == 3);
+}
+
+TEST_CASE("a function is constructible only from callables with a compatible "
+          "signature")
+{
+    using F = composer::function<int(int)>;
+    STATIC_REQUIRE(std::is_constructible_v<F, int (*)(int)>);
+    STATIC_REQUIRE(std::is_constructible_v<F, decltype(composer::plus(1))>);
+    STATIC_REQUIRE(!std::is_constructible_v<F, int (*)(int, int)>);
+    STATIC_REQUIRE(!std::is_constructible_v<F, decltype(composer::plus)>);
+    STATIC_REQUIRE(!std::is_constructible_v<F, std::unique_ptr<int>>);
+}
+
+TEST_CASE("a function can call through a pointer to member")
+{
+    composer::function<int(const numname&)> f = &numname::num;
+    REQUIRE(f(numname{ 3, "three" }) == 3);
+}
+
+TEST_CASE("small states are stored inline and large states on the heap")
+{
+    using F = composer::function<int(int)>;
+    auto small = composer::plus(1);
+    auto large = [a = std::array<int, 32>{ 1 }](int x) { return x + a[0]; };
+    STATIC_REQUIRE(F::stores_inline<decltype(small)>);
+    STATIC_REQUIRE(!F::stores_inline<decltype(large)>);
+    F fs = small;
+    F fl = large;
+    REQUIRE(fs(2) == 3);
+    REQUIRE(fl(2) == 3);
+}
+
+TEST_CASE("the inline buffer size is configurable")
+{
+    auto state = [a = std::array<int, 16>{ 1 }](int x) { return x + a[0]; };
+    STATIC_REQUIRE(
+        !composer::function<int(int)>::stores_inline<decltype(state)>);
+    STATIC_REQUIRE(
+        composer::function<int(int), 64>::stores_inline<decltype(state)>);
+    composer::function<int(int), 64> f = state;
+    REQUIRE(f(2) == 3);
+}
+
+TEST_CASE("copies of a function have independent states")
+{
+    SECTION("inline state")
+    {
+        composer::function<int()> f = [n = 0]() mutable { return ++n; };
+        REQUIRE(f() == 1);
+        auto g = f;
+        REQUIRE(f() == 2);
+        REQUIRE(f() == 3);
+        REQUIRE(g() == 2);
+    }
+    SECTION("heap state")
+    {
+        composer::function<int()> f
+            = [n = 0, a = std::array<int, 32>{}]() mutable {
+                  return ++n + a[0];
+              };
+        REQUIRE(f() == 1);
+        auto g = f;
+        REQUIRE(f() == 2);
+        g = f;
+        REQUIRE(f() == 3);
+        REQUIRE(g() == 3);
+    }
+}
+
+TEST_CASE("a moved function keeps its state")
+{
+    composer::function<int()> f
+        = [n = 0, p = std::make_shared<int>(5)]() mutable { return ++n + *p; };
+    REQUIRE(f() == 6);
+    auto g = std::move(f);
+    REQUIRE(g() == 7);
+    composer::function<int()> h;
+    h = std::move(g);
+    REQUIRE(h() == 8);
+}
+
+TEST_CASE("a function is a composable function")
+{
+    composer::function<int(int)> f = composer::multiplies(2);
+    STATIC_REQUIRE(composer::composable_function_type<decltype(f)>);
+
+    SECTION("it can be called with pipe syntax")
+    {
+        REQUIRE((3 | f) == 6);
+    }
+    SECTION("it can be piped into")
+    {
+        auto g = composer::plus(1) | f;
+        REQUIRE(g(3) == 8);
+    }
+    SECTION("it can be piped from")
+    {
+        auto g = f | composer::plus(1);
+        STATIC_REQUIRE(composer::composable_function_type<decltype(g)>);
+        REQUIRE(g(3) == 7);
+    }
+    SECTION("it can be combined with operators")
+    {
+        auto g = f > composer::identity;
+        REQUIRE(g(1));
+        REQUIRE(!g(-1));
+    }
+    SECTION("it can be used with transform_args")
+    {
+        composer::function<bool(int, int)> less = composer::less_than;
+        auto by_num = composer::transform_args(&numname::num, less);
+        REQUIRE(by_num(numname{ 1, "one" }, numname{ 2, "two" }));
+        REQUIRE(!by_num(numname{ 2, "two" }, numname{ 1, "one" }));
+    }
+}
+
+TEST_CASE("functions chosen at run time can be stored and used with "
+          "algorithms")
+{
+    std::vector<composer::function<bool(const numname&)>> rules;
+    rules.emplace_back(&numname::num | composer::greater_than(1));
+    rules.emplace_back(&numname::name | composer::equal_to("three"));
+
+    constexpr std::array values{ numname{ 1, "one" },
+                                 numname{ 2, "two" },
+                                 numname{ 3, "three" } };
+    REQUIRE((values | composer::count_if(rules[0])) == 2);
+    REQUIRE((values | composer::count_if(rules[1])) == 1);
+    REQUIRE((values | composer::find_if(rules[0] && rules[1]))->num == 3);
+}
@@ -0,0 +1,154 @@
+#include <composer/algorithm.hpp>
+#include <composer/function_ref.hpp>
+#include <composer/functional.hpp>
+#include <composer/transform_args.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+struct numname {
+    int num;
+    std::string_view name;
+};
+
+constexpr std::array values{ numname{ 1, "one" },
+                             numname{ 2, "two" },
+                             numname{ 3, "three" } };
+
+// Stands in for code in a compiled library, that can't be a template.
+std::ptrdiff_t
+count_matching(std::span<const numname> s,
+               composer::function_ref<bool(const numname&)> pred)
+{
+    return s | composer::count_if(pred);
+}
+
+int twice(int x)
+{
+    return x * 2;
+}
+
+struct copy_counter {
+    int* copies;
+
+    copy_counter(int* c) : copies(c) {}
+
+    copy_counter(const copy_counter& other) : copies(other.copies)
+    {
+        ++*copies;
+    }
+
+    bool operator()(const numname& n) const { return n.num > 1; }
+};
+} // namespace
+
+TEST_CASE("a function_ref is two pointers")
+{
+    STATIC_REQUIRE(sizeof(composer::function_ref<int(int)>)
+                   == 2 * sizeof(void*));
+    STATIC_REQUIRE(
+        std::is_trivially_copyable_v<composer::function_ref<int(int)>>);
+}
+
+TEST_CASE("a function_ref calls the referred callable")
+{
+    auto minus = [](int a, int b) { return a - b; };
+    composer::function_ref<int(int, int)> f = minus;
+    REQUIRE(f(5, 2) == 3);
+}
+
+TEST_CASE("a function_ref can refer to a function")
+{
+    composer::function_ref<int(int)> f = twice;
+    REQUIRE(f(3) == 6);
+    composer::function_ref<int(int)> g = &twice;
+    REQUIRE(g(4) == 8);
+}
+
+TEST_CASE("a function_ref refers to the state of the callable and does not "
+          "copy it")
+{
+    int n = 0;
+    auto counter = [&n, m = 0]() mutable {
+        n = ++m;
+        return m;
+    };
+    composer::function_ref<int()> f = counter;
+    REQUIRE(f() == 1);
+    REQUIRE(f() == 2);
+    REQUIRE(counter() == 3);
+    REQUIRE(n == 3);
+
+    int copies = 0;
+    copy_counter pred{ &copies };
+    REQUIRE(count_matching(values, pred) == 2);
+    REQUIRE(copies == 0);
+}
+
+TEST_CASE("a function_ref is constructible only from callables with a "
+          "compatible signature")
+{
+    using F = composer::function_ref<int(int)>;
+    STATIC_REQUIRE(std::is_constructible_v<F, int (&)(int)>);
+    STATIC_REQUIRE(std::is_constructible_v<F, decltype(composer::plus(1))&>);
+    STATIC_REQUIRE(!std::is_constructible_v<F, int (*)(int, int)>);
+    STATIC_REQUIRE(!std::is_constructible_v<F, decltype(composer::plus)&>);
+    STATIC_REQUIRE(!std::is_constructible_v<F, int numname::*>);
+}
+
+TEST_CASE("a function_ref is a composable function")
+{
+    constexpr auto times2 = composer::multiplies(2);
+    composer::function_ref<int(int)> f = times2;
+    STATIC_REQUIRE(composer::composable_function_type<decltype(f)>);
+
+    SECTION("it can be called with pipe syntax")
+    {
+        REQUIRE((3 | f) == 6);
+    }
+    SECTION("it can be piped into")
+    {
+        auto g = composer::plus(1) | f;
+        REQUIRE(g(3) == 8);
+    }
+    SECTION("it can be piped from")
+    {
+        auto g = f | composer::plus(1);
+        STATIC_REQUIRE(composer::composable_function_type<decltype(g)>);
+        REQUIRE(g(3) == 7);
+    }
+    SECTION("it can be combined with operators")
+    {
+        auto g = f > composer::identity;
+        REQUIRE(g(1));
+        REQUIRE(!g(-1));
+    }
+    SECTION("it can be used with transform_args")
+    {
+        constexpr auto less_than = composer::less_than;
+        composer::function_ref<bool(int, int)> less = less_than;
+        auto by_num = composer::transform_args(&numname::num, less);
+        REQUIRE(by_num(numname{ 1, "one" }, numname{ 2, "two" }));
+        REQUIRE(!by_num(numname{ 2, "two" }, numname{ 1, "one" }));
+    }
+}
+
+TEST_CASE("a function_ref passes a pipeline with bound state to non-template "
+          "code")
+{
+    const std::vector<int> wanted{ 1, 3 };
+    const auto pred = composer::mem_fn(&numname::num)
+                    | [&wanted](int n) {
+                          return std::ranges::find(wanted, n) != wanted.end();
+                      };
+    REQUIRE(count_matching(values, pred) == 2);
+    REQUIRE(count_matching(values, &numname::num | composer::greater_than(1))
+            == 2);
+}
@@ -657,3 +657,71 @@ TEST_CASE("composable functions can compose with operator>>")
     STATIC_REQUIRE((mem_fn(&XY::x) >> mem_fn(&XY::y))(xy) == 3);
     REQUIRE((mem_fn(&XY::x) >> mem_fn(&XY::y))(xy) == 3);
 }
+
+TEST_CASE("all is true if all functions are true")
+{
+    static constexpr auto eq4 = composer::make_composable_function(
+        [](auto x) -> decltype(x == 4) { return x == 4; });
+    constexpr auto p = composer::all(&numname::num | eq4,
+                                     &numname::name | length | eq4,
+                                     &numname::num | composer::less_than(5));
+    STATIC_REQUIRE(p(four));
+    STATIC_REQUIRE_FALSE(p(five));
+    REQUIRE(p(four));
+    REQUIRE_FALSE(p(five));
+}
+
+TEST_CASE("any is true if any function is true")
+{
+    static constexpr auto eq4 = composer::make_composable_function(
+        [](auto x) -> decltype(x == 4) { return x == 4; });
+    constexpr auto p
+        = composer::any(&numname::num | eq4, &numname::name | length | eq4);
+    STATIC_REQUIRE(p(five));
+    STATIC_REQUIRE_FALSE(p(three));
+    REQUIRE(p(five));
+    REQUIRE_FALSE(p(three));
+}
+
+TEST_CASE("all and any call every function")
+{
+    int calls = 0;
+    const auto f = composer::make_composable_function([&calls](int i) {
+        ++calls;
+        return i > 0;
+    });
+    REQUIRE_FALSE(composer::all(f, f, f)(0));
+    REQUIRE(calls == 3);
+    REQUIRE(composer::any(f, f)(1));
+    REQUIRE(calls == 5);
+}
+
+TEST_CASE("select chooses one of the results by a condition")
+{
+    constexpr auto abs = composer::select(
+        composer::less_than(0), composer::negate, composer::identity);
+    STATIC_REQUIRE(abs(-3) == 3);
+    STATIC_REQUIRE(abs(4) == 4);
+    REQUIRE(abs(-3) == 3);
+    REQUIRE(abs(4) == 4);
+    SECTION("the result is the common type of the alternatives")
+    {
+        constexpr auto f = composer::select(composer::less_than(0),
+                                            composer::negate,
+                                            composer::multiplies(0.5));
+        STATIC_REQUIRE(std::is_same_v<decltype(f(1)), double>);
+        STATIC_REQUIRE(f(-2) == 2.0);
+        STATIC_REQUIRE(f(3) == 1.5);
+    }
+    SECTION("both alternatives are called")
+    {
+        int calls = 0;
+        const auto count = composer::make_composable_function([&calls](int i) {
+            ++calls;
+            return i;
+        });
+        const auto f = composer::select(composer::less_than(0), count, count);
+        REQUIRE(f(1) == 1);
+        REQUIRE(calls == 2);
+    }
+}
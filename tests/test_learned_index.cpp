@@ -0,0 +1,103 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/learned_index.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+namespace {
+struct event {
+    std::int64_t timestamp;
+    int value;
+};
+
+// Sorted keys, spread out evenly when uneven is false, and in clusters
+// with long gaps between them otherwise.
+std::vector<std::int64_t> sorted_keys(std::int64_t size, bool uneven)
+{
+    std::vector<std::int64_t> v;
+    for (std::int64_t i = 0; i != size; ++i) {
+        v.push_back(uneven ? i / 100 * 1'000'000 + i % 100 : i * 10 + i % 3);
+    }
+    return v;
+}
+} // namespace
+
+TEST_CASE("a learned_index is a range of the elements of the indexed range")
+{
+    const auto keys = sorted_keys(1000, false);
+    const composer::learned_index index(keys);
+    STATIC_REQUIRE(std::ranges::random_access_range<decltype(index)>);
+    REQUIRE(std::ranges::equal(index, keys));
+    SECTION("with one segment for evenly spread keys")
+    {
+        REQUIRE(index.segments() == 1);
+    }
+}
+
+TEST_CASE("binary search algorithms search a learned_index like the range")
+{
+    for (bool uneven : { false, true }) {
+        for (std::int64_t size : { 0, 1, 2, 100, 10000 }) {
+            auto keys = sorted_keys(size, uneven);
+            if (size != 0) {
+                // Repeated keys.
+                keys.insert(keys.begin() + size / 2, 500, keys[size / 2]);
+            }
+            const composer::learned_index index(keys, std::identity{}, 8);
+            const auto largest = keys.empty() ? 0 : keys.back();
+            for (std::int64_t i = 0; i <= 1000; ++i) {
+                const auto value = largest * i / 1000 + i % 7 - 3;
+                const auto position = [&](auto it) {
+                    return it - index.begin();
+                };
+                REQUIRE(position(composer::lower_bound(index, value))
+                        == std::ranges::lower_bound(keys, value)
+                               - keys.begin());
+                REQUIRE(position(composer::upper_bound(index, value))
+                        == std::ranges::upper_bound(keys, value)
+                               - keys.begin());
+                REQUIRE(composer::binary_search(index, value)
+                        == std::ranges::binary_search(keys, value));
+                const auto [first, last] = composer::equal_range(
+                    index, value, composer::less_than);
+                REQUIRE(last - first == std::ranges::count(keys, value));
+            }
+        }
+    }
+}
+
+TEST_CASE("a learned_index predicts positions from projected keys")
+{
+    std::vector<event> events;
+    for (int i = 0; i != 10000; ++i) {
+        events.push_back({ 1'700'000'000 + 60 * i, i });
+    }
+    const composer::learned_index index(events, &event::timestamp);
+    REQUIRE(composer::lower_bound(index, 1'700'000'000 + 60 * 4321)->value
+            == 4321);
+    REQUIRE(composer::upper_bound(index, 1'700'000'000 + 60 * 4321)->value
+            == 4322);
+    SECTION("with std::ranges::less or composer::less_than")
+    {
+        STATIC_REQUIRE(
+            std::is_invocable_v<composer::internal::index_lower_bound,
+                                decltype(index)&,
+                                int,
+                                decltype(composer::less_than)>);
+    }
+    SECTION("but comparisons other than less search the elements")
+    {
+        STATIC_REQUIRE_FALSE(
+            std::is_invocable_v<composer::internal::index_lower_bound,
+                                decltype(index)&,
+                                int,
+                                decltype(composer::greater_than)>);
+    }
+}
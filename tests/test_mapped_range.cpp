@@ -0,0 +1,169 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/mapped_range.hpp>
+#include <composer/transform_args.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#if __has_include(<sys/mman.h>)
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+struct record {
+    std::uint32_t id;
+    std::int32_t value;
+};
+
+// A file in the temporary directory, that is removed when it goes out of
+// scope.
+struct temp_file {
+    std::filesystem::path path;
+
+    explicit temp_file(const std::string& name)
+        : path(std::filesystem::temp_directory_path()
+               / ("composer_" + std::to_string(::getpid()) + "_" + name))
+    {
+    }
+
+    temp_file(const temp_file&) = delete;
+    temp_file& operator=(const temp_file&) = delete;
+
+    ~temp_file() { std::filesystem::remove(path); }
+};
+
+template <typename T>
+void write_file(const std::filesystem::path& path, const std::vector<T>& v)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(v.data()),
+              static_cast<std::streamsize>(v.size() * sizeof(T)));
+}
+
+template <typename T>
+std::vector<T> read_file(const std::filesystem::path& path)
+{
+    std::vector<T> v(std::filesystem::file_size(path) / sizeof(T));
+    std::ifstream in(path, std::ios::binary);
+    in.read(reinterpret_cast<char*>(v.data()),
+            static_cast<std::streamsize>(v.size() * sizeof(T)));
+    return v;
+}
+
+std::vector<record> records(std::uint32_t n)
+{
+    std::vector<record> v;
+    for (std::uint32_t i = 0; i != n; ++i) {
+        v.push_back({ i, static_cast<std::int32_t>(i % 100) - 50 });
+    }
+    return v;
+}
+} // namespace
+
+TEST_CASE("a mapped file is a contiguous range of its records")
+{
+    STATIC_REQUIRE(
+        std::ranges::contiguous_range<composer::mapped_range<record>>);
+    STATIC_REQUIRE(std::ranges::sized_range<composer::mapped_range<record>>);
+    STATIC_REQUIRE(std::same_as<std::ranges::range_reference_t<
+                                    composer::mapped_range<record>>,
+                                const record&>);
+    STATIC_REQUIRE(
+        std::same_as<std::ranges::range_reference_t<composer::mapped_range<
+                         record,
+                         composer::map_mode::read_write>>,
+                     record&>);
+
+    const temp_file file("records");
+    write_file(file.path, records(10000));
+    const composer::mapped_range<record> mapped(
+        file.path, composer::access_advice::sequential);
+    REQUIRE(mapped.size() == 10000);
+    REQUIRE(mapped[1234].id == 1234);
+    SECTION("composer algorithms run directly over the mapping")
+    {
+        const auto by_id = composer::transform_args(&record::id);
+        REQUIRE(composer::count_if(mapped,
+                                   &record::value | composer::less_than(0))
+                == 5000);
+        REQUIRE(composer::find_if(mapped,
+                                  &record::value | composer::equal_to(49))
+                == mapped.begin() + 99);
+        REQUIRE(composer::lower_bound(
+                    mapped, record{ 777, 0 }, by_id(composer::less_than))
+                == mapped.begin() + 777);
+        REQUIRE(composer::is_sorted(mapped, by_id(composer::less_than)));
+    }
+    SECTION("and in parallel")
+    {
+        constexpr composer::parallel_policy par_always{ .threshold = 2 };
+        mapped.advise(composer::access_advice::willneed);
+        REQUIRE(composer::count_if(par_always,
+                                   mapped,
+                                   &record::value | composer::equal_to(0))
+                == 100);
+    }
+    SECTION("bytes after the last whole record are not part of the range")
+    {
+        std::ofstream(file.path, std::ios::binary | std::ios::app) << "xyz";
+        REQUIRE(composer::mapped_range<record>(file.path).size() == 10000);
+    }
+}
+
+TEST_CASE("changes to a read_write mapping are written to the file")
+{
+    using writable = composer::mapped_range<std::int64_t,
+                                            composer::map_mode::read_write>;
+    const temp_file file("numbers");
+    SECTION("an existing file is mapped as it is")
+    {
+        write_file(file.path, std::vector<std::int64_t>{ 3, 1, 2 });
+        writable mapped(file.path);
+        composer::sort(mapped, composer::greater_than);
+        mapped.flush();
+        REQUIRE(read_file<std::int64_t>(file.path)
+                == std::vector<std::int64_t>{ 3, 2, 1 });
+    }
+    SECTION("a file is created with the given number of elements")
+    {
+        {
+            writable mapped(file.path, 1000, composer::access_advice::random);
+            REQUIRE(composer::all_of(mapped, composer::equal_to(0)));
+            composer::fill(mapped, 7);
+        }
+        REQUIRE(read_file<std::int64_t>(file.path)
+                == std::vector<std::int64_t>(1000, 7));
+    }
+    SECTION("a moved mapping is owned by its new range")
+    {
+        writable mapped(file.path, 10);
+        const auto data = mapped.data();
+        writable moved = std::move(mapped);
+        REQUIRE(moved.data() == data);
+        REQUIRE(moved.size() == 10);
+        REQUIRE(mapped.empty());
+    }
+}
+
+TEST_CASE("empty files are empty ranges, and missing files throw")
+{
+    const temp_file file("empty");
+    write_file(file.path, std::vector<record>{});
+    const composer::mapped_range<record> mapped(file.path);
+    REQUIRE(mapped.empty());
+    REQUIRE(composer::find_if(mapped, &record::id | composer::equal_to(0U))
+            == mapped.end());
+    REQUIRE_THROWS_AS(composer::mapped_range<record>(file.path / "missing"),
+                      std::system_error);
+}
+
+#endif
@@ -0,0 +1,151 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/memoize.hpp>
+#include <composer/transform_args.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+struct numname {
+    int num;
+    std::string_view name;
+};
+
+int calls = 0;
+
+int square(int x)
+{
+    ++calls;
+    return x * x;
+}
+} // namespace
+
+TEST_CASE("a memoized function calls the function once per key")
+{
+    calls = 0;
+    auto f = composer::memoize(square);
+    STATIC_REQUIRE(composer::composable_function_type<decltype(f)>);
+    REQUIRE(f(3) == 9);
+    REQUIRE(f(3) == 9);
+    REQUIRE(calls == 1);
+    for (int i = 0; i != 1000; ++i) {
+        REQUIRE(f(i) == i * i);
+    }
+    REQUIRE(calls == 1000);
+    for (int i = 0; i != 1000; ++i) {
+        REQUIRE(f(i) == i * i);
+    }
+    REQUIRE(calls == 1000);
+}
+
+TEST_CASE("copies of a memoized function share the cache")
+{
+    calls = 0;
+    auto f = composer::memoize(square);
+    auto g = f;
+    REQUIRE(f(4) == 16);
+    REQUIRE(g(4) == 16);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("the key type of a generic function is given explicitly")
+{
+    int n = 0;
+    auto f = composer::memoize<std::string>([&n](const auto& s) {
+        ++n;
+        return s.size();
+    });
+    REQUIRE(f("abc") == 3);
+    REQUIRE(f(std::string("abc")) == 3);
+    REQUIRE(n == 1);
+}
+
+TEST_CASE("an lru cache evicts the least recently used key")
+{
+    calls = 0;
+    auto f = composer::memoize(square, composer::lru_cache{ .capacity = 2 });
+    REQUIRE(f(1) == 1);
+    REQUIRE(f(2) == 4);
+    REQUIRE(f(1) == 1);
+    REQUIRE(calls == 2);
+    REQUIRE(f(3) == 9);
+    REQUIRE(calls == 3);
+    REQUIRE(f(1) == 1);
+    REQUIRE(calls == 3);
+    REQUIRE(f(2) == 4);
+    REQUIRE(calls == 4);
+}
+
+TEST_CASE("a direct mapped cache replaces the key in a slot")
+{
+    calls = 0;
+    auto f = composer::memoize(square,
+                               composer::direct_mapped_cache{ .slots = 1 });
+    REQUIRE(f(1) == 1);
+    REQUIRE(f(1) == 1);
+    REQUIRE(calls == 1);
+    REQUIRE(f(2) == 4);
+    REQUIRE(f(1) == 1);
+    REQUIRE(calls == 3);
+}
+
+TEST_CASE("a memoized function composes like any composable function")
+{
+    int n = 0;
+    auto length = composer::memoize([&n](std::string_view s) {
+        ++n;
+        return s.size();
+    });
+    std::array<numname, 4> values{ numname{ 3, "three" },
+                                   numname{ 1, "one" },
+                                   numname{ 4, "four" },
+                                   numname{ 2, "two" } };
+    composer::sort(values,
+                   composer::transform_args(&numname::name | length,
+                                            composer::less_than));
+    REQUIRE(values[0].name.size() == 3);
+    REQUIRE(values[3].name == "three");
+    REQUIRE(n == 4);
+    REQUIRE((values | composer::count_if(&numname::name | length
+                                         | composer::equal_to(3U)))
+            == 2);
+    REQUIRE(n == 4);
+}
+
+TEST_CASE("a concurrent cache can be used from several threads")
+{
+    std::atomic<int> n = 0;
+    auto f = composer::memoize(
+        [&n](int x) {
+            ++n;
+            return x + 1;
+        },
+        composer::concurrent_cache{ composer::lru_cache{ .capacity = 100 },
+                                    4 });
+    std::atomic<bool> ok = true;
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t) {
+        threads.emplace_back([&f, &ok] {
+            for (int i = 0; i != 10000; ++i) {
+                if (f(i % 50) != i % 50 + 1) {
+                    ok = false;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    REQUIRE(ok);
+    REQUIRE(n >= 50);
+    REQUIRE(n <= 4 * 50);
+}
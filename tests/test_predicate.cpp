@@ -0,0 +1,224 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/predicate.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace {
+struct point {
+    int x;
+    int y;
+};
+
+constexpr auto is_odd = composer::make_composable_function(
+    composer::nodiscard{ [](int i) { return i % 2 == 1; } });
+
+template <typename P>
+constexpr composer::predicate_kind kind_of(const P&)
+{
+    return composer::predicate_kind_v<P>;
+}
+} // namespace
+
+TEST_CASE("bound comparisons are recognized with their operands")
+{
+    using enum composer::predicate_kind;
+    STATIC_REQUIRE(kind_of(composer::equal_to(3)) == equal_to);
+    STATIC_REQUIRE(kind_of(composer::not_equal_to(3)) == not_equal_to);
+    STATIC_REQUIRE(kind_of(composer::less_than(3)) == less);
+    STATIC_REQUIRE(kind_of(composer::less_or_equal_to(3)) == less_equal);
+    STATIC_REQUIRE(kind_of(composer::greater_than(3)) == greater);
+    STATIC_REQUIRE(kind_of(composer::greater_or_equal_to(3)) == greater_equal);
+    STATIC_REQUIRE(composer::predicate_operand(composer::less_than(3)) == 3);
+    STATIC_REQUIRE(
+        std::same_as<
+            composer::predicate_projection_t<decltype(composer::less_than(3))>,
+            std::identity>);
+    SECTION("an operand bound by reference is the referenced object")
+    {
+        int x = 3;
+        const auto lt = composer::less_than(composer::cref(x));
+        REQUIRE(&composer::predicate_operand(lt) == &x);
+    }
+}
+
+TEST_CASE("a comparison after a projection is recognized with the projection")
+{
+    constexpr auto gt5 = &point::x | composer::greater_than(5);
+    STATIC_REQUIRE(kind_of(gt5) == composer::predicate_kind::greater);
+    STATIC_REQUIRE(composer::predicate_operand(gt5) == 5);
+    constexpr auto proj = composer::predicate_projection(gt5);
+    STATIC_REQUIRE(proj(point{ 8, 1 }) == 8);
+
+    constexpr auto mod = composer::identity | composer::modulus(7)
+                       | composer::equal_to(3);
+    STATIC_REQUIRE(kind_of(mod) == composer::predicate_kind::equal_to);
+    STATIC_REQUIRE(composer::predicate_projection(mod)(10) == 3);
+    SECTION("identity is no projection")
+    {
+        constexpr auto eq = composer::identity | composer::equal_to(3);
+        STATIC_REQUIRE(kind_of(eq) == composer::predicate_kind::equal_to);
+        STATIC_REQUIRE(
+            std::same_as<composer::predicate_projection_t<decltype(eq)>,
+                         std::identity>);
+    }
+}
+
+TEST_CASE("logical combinations are recognized with their operands")
+{
+    constexpr auto lt = composer::less_than(3);
+    constexpr auto gt = &point::y | composer::greater_than(5);
+    SECTION("&&")
+    {
+        constexpr auto p = (composer::identity | lt) && is_odd;
+        STATIC_REQUIRE(kind_of(p) == composer::predicate_kind::logical_and);
+        STATIC_REQUIRE(kind_of(composer::predicate_child<0>(p))
+                       == composer::predicate_kind::less);
+        STATIC_REQUIRE(kind_of(composer::predicate_child<1>(p))
+                       == composer::predicate_kind::opaque);
+    }
+    SECTION("||")
+    {
+        constexpr auto p = gt || (&point::x | lt);
+        STATIC_REQUIRE(kind_of(p) == composer::predicate_kind::logical_or);
+        STATIC_REQUIRE(composer::predicate_operand(
+                           composer::predicate_child<0>(p))
+                       == 5);
+        STATIC_REQUIRE(composer::predicate_operand(
+                           composer::predicate_child<1>(p))
+                       == 3);
+    }
+    SECTION("!")
+    {
+        constexpr auto p = !gt;
+        STATIC_REQUIRE(kind_of(p) == composer::predicate_kind::logical_not);
+        constexpr auto c = composer::predicate_child<0>(p);
+        STATIC_REQUIRE(kind_of(c) == composer::predicate_kind::greater);
+        STATIC_REQUIRE(c(point{ 1, 6 }));
+        STATIC_REQUIRE(!p(point{ 1, 6 }));
+    }
+}
+
+TEST_CASE("other functions are opaque")
+{
+    using composer::predicate_kind;
+    STATIC_REQUIRE(kind_of(is_odd) == predicate_kind::opaque);
+    STATIC_REQUIRE(kind_of(composer::equal_to) == predicate_kind::opaque);
+    STATIC_REQUIRE(kind_of(composer::plus(3)) == predicate_kind::opaque);
+    STATIC_REQUIRE(kind_of(composer::less_than(3) | composer::logical_not)
+                   == predicate_kind::logical_not);
+    STATIC_REQUIRE(kind_of(composer::less_than(3) | composer::equal_to(true))
+                   == predicate_kind::equal_to);
+    STATIC_REQUIRE(kind_of([](int i) { return i == 3; })
+                   == predicate_kind::opaque);
+    STATIC_REQUIRE(!composer::comparison_predicate<decltype(is_odd)>);
+    STATIC_REQUIRE(!composer::logical_predicate<decltype(is_odd)>);
+}
+
+TEST_CASE("algorithms use the vectorized search for recognized predicates")
+{
+    using namespace composer::internal;
+    using ints = std::vector<int>&;
+    STATIC_REQUIRE(std::is_invocable_v<vectorized_find_if,
+                                       ints,
+                                       decltype(composer::equal_to(3))>);
+    STATIC_REQUIRE(std::is_invocable_v<vectorized_count_if,
+                                       ints,
+                                       decltype(composer::not_equal_to(3))>);
+    STATIC_REQUIRE(
+        std::is_invocable_v<vectorized_find_if,
+                            ints,
+                            decltype(composer::identity
+                                     | composer::equal_to(3))>);
+    STATIC_REQUIRE(std::is_invocable_v<vectorized_find_if,
+                                       ints,
+                                       decltype(composer::less_than(3))>);
+    STATIC_REQUIRE(std::is_invocable_v<vectorized_all_of,
+                                       ints,
+                                       decltype(composer::greater_than(3))>);
+    STATIC_REQUIRE(
+        !std::is_invocable_v<vectorized_find_if,
+                             ints,
+                             decltype(composer::less_or_equal_to(3))>);
+    STATIC_REQUIRE(!std::is_invocable_v<vectorized_find_if,
+                                        ints,
+                                        decltype(composer::less_than(3U))>);
+    STATIC_REQUIRE(
+        !std::is_invocable_v<vectorized_find_if,
+                             ints,
+                             decltype(composer::negate
+                                      | composer::equal_to(3))>);
+    STATIC_REQUIRE(!std::is_invocable_v<vectorized_find_if,
+                                        ints,
+                                        decltype(composer::equal_to(3)),
+                                        std::negate<>>);
+
+    std::vector<int> v(1000, 1);
+    v[700] = 3;
+    v[900] = 3;
+    REQUIRE(composer::find_if(v, composer::equal_to(3)) == v.begin() + 700);
+    REQUIRE(composer::find_if_not(v, composer::not_equal_to(3))
+            == v.begin() + 700);
+    REQUIRE(composer::count_if(v, composer::equal_to(3)) == 2);
+    REQUIRE(composer::count_if(v, composer::not_equal_to(3)) == 998);
+    REQUIRE((v | composer::count_if(composer::equal_to(1))) == 998);
+    REQUIRE(composer::any_of(v, composer::equal_to(3)));
+    REQUIRE(!composer::none_of(v, composer::equal_to(3)));
+    REQUIRE(!composer::all_of(v, composer::not_equal_to(3)));
+    REQUIRE(composer::all_of(v, composer::not_equal_to(4)));
+    REQUIRE(composer::find_if(v, composer::equal_to(3), std::negate<>{})
+            == v.end());
+    REQUIRE(composer::count_if(v, composer::equal_to(-3), std::negate<>{})
+            == 2);
+}
+
+TEST_CASE("algorithms use the vectorized search for ordered comparisons")
+{
+    std::vector<int> v(1000, 1);
+    v[300] = -2;
+    v[700] = 3;
+    v[900] = 3;
+    REQUIRE(composer::find_if(v, composer::less_than(0)) == v.begin() + 300);
+    REQUIRE(composer::find_if(v, composer::greater_than(2))
+            == v.begin() + 700);
+    REQUIRE(composer::find_if_not(v, composer::less_than(2))
+            == v.begin() + 700);
+    REQUIRE(composer::find_if_not(v, composer::greater_than(-1))
+            == v.begin() + 300);
+    REQUIRE(composer::count_if(v, composer::less_than(1)) == 1);
+    REQUIRE(composer::count_if(v, composer::greater_than(1)) == 2);
+    REQUIRE(composer::any_of(v, composer::greater_than(2)));
+    REQUIRE(composer::none_of(v, composer::greater_than(3)));
+    REQUIRE(composer::all_of(v, composer::less_than(4)));
+    REQUIRE(!composer::all_of(v, composer::greater_than(-2)));
+}
+
+TEST_CASE("algorithms with recognized predicates work in constant evaluation")
+{
+    constexpr std::array values{ 3, 1, 4, 1, 5, 9, 2, 6 };
+    STATIC_REQUIRE(composer::find_if(values, composer::equal_to(5))
+                   == values.begin() + 4);
+    STATIC_REQUIRE(composer::count_if(values, composer::not_equal_to(1)) == 6);
+    STATIC_REQUIRE(composer::none_of(values, composer::equal_to(7)));
+}
+
+TEST_CASE("all and any are recognized with all of their operands")
+{
+    constexpr auto lt = composer::less_than(3);
+    constexpr auto p = composer::all(lt, is_odd, composer::greater_than(-5));
+    STATIC_REQUIRE(kind_of(p) == composer::predicate_kind::logical_and);
+    STATIC_REQUIRE(composer::predicate_child_count_v<decltype(p)> == 3);
+    STATIC_REQUIRE(composer::predicate_operand(composer::predicate_child<2>(p))
+                   == -5);
+    constexpr auto q = composer::any(lt, is_odd);
+    STATIC_REQUIRE(kind_of(q) == composer::predicate_kind::logical_or);
+    STATIC_REQUIRE(composer::predicate_child_count_v<decltype(q)> == 2);
+    STATIC_REQUIRE(kind_of(composer::select(lt, is_odd, is_odd))
+                   == composer::predicate_kind::opaque);
+}
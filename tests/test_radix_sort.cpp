@@ -0,0 +1,211 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/radix_sort.hpp>
+#include <composer/transform_args.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct record {
+    int num;
+    std::size_t seq;
+};
+
+enum class level : std::int8_t { low = -1, mid = 0, high = 1 };
+
+// A deterministic sequence that covers all bytes of the values.
+template <typename T>
+std::vector<T> scrambled(std::size_t size)
+{
+    std::vector<T> v;
+    v.reserve(size);
+    std::uint64_t x = 88172645463325252ULL;
+    for (std::size_t i = 0; i != size; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        v.push_back(static_cast<T>(x));
+    }
+    return v;
+}
+
+template <typename T>
+void check_same_as_std(std::size_t size)
+{
+    auto v = scrambled<T>(size);
+    auto expected = v;
+    std::ranges::sort(expected);
+    composer::radix_sort(v);
+    REQUIRE(v == expected);
+    std::ranges::sort(expected, std::ranges::greater{});
+    composer::radix_sort(v, composer::greater_than);
+    REQUIRE(v == expected);
+}
+
+} // namespace
+
+TEST_CASE("radix_sort sorts integers like std::ranges::sort")
+{
+    for (std::size_t size : { 0, 1, 2, 100, 5000 }) {
+        check_same_as_std<std::int8_t>(size);
+        check_same_as_std<std::uint8_t>(size);
+        check_same_as_std<std::int16_t>(size);
+        check_same_as_std<std::uint16_t>(size);
+        check_same_as_std<std::int32_t>(size);
+        check_same_as_std<std::uint32_t>(size);
+        check_same_as_std<std::int64_t>(size);
+        check_same_as_std<std::uint64_t>(size);
+    }
+    SECTION("including the extremes")
+    {
+        std::vector<int> v{ 0,
+                            std::numeric_limits<int>::max(),
+                            -1,
+                            std::numeric_limits<int>::min(),
+                            1 };
+        composer::radix_sort(v);
+        REQUIRE(v
+                == std::vector<int>{ std::numeric_limits<int>::min(),
+                                     -1,
+                                     0,
+                                     1,
+                                     std::numeric_limits<int>::max() });
+    }
+}
+
+TEST_CASE("radix_sort sorts floating point values like operator<")
+{
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+    std::vector<double> v{ 2.5, -0.0, -inf, 1e-300, -1.5, inf, 0.0, -1e-300 };
+    composer::radix_sort(v);
+    REQUIRE(std::ranges::is_sorted(v));
+    REQUIRE(v.front() == -inf);
+    REQUIRE(v.back() == inf);
+    SECTION("with -0.0 and 0.0 as equal keys, that keep their order")
+    {
+        REQUIRE(std::signbit(v[3]));
+        REQUIRE(!std::signbit(v[4]));
+    }
+    SECTION("descending")
+    {
+        std::vector<float> f{ 0.5F, -3.0F, 7.25F, -0.125F };
+        composer::radix_sort(f, std::ranges::greater{});
+        REQUIRE(f == std::vector<float>{ 7.25F, 0.5F, -0.125F, -3.0F });
+    }
+}
+
+TEST_CASE("radix_sort sorts enums by their values")
+{
+    std::vector<level> v{ level::high, level::low, level::mid, level::low };
+    composer::radix_sort(v);
+    REQUIRE(v
+            == std::vector<level>{ level::low, level::low, level::mid,
+                                   level::high });
+}
+
+TEST_CASE("radix_sort is stable and sorts by projections")
+{
+    auto nums = scrambled<std::uint8_t>(3000);
+    std::vector<record> v;
+    for (auto n : nums) {
+        v.push_back({ n % 10 - 5, v.size() });
+    }
+    const auto by_num_then_seq = [](const record& a, const record& b) {
+        return a.num < b.num || (a.num == b.num && a.seq < b.seq);
+    };
+    SECTION("with the projection after the comparison")
+    {
+        composer::radix_sort(v, std::ranges::less{}, &record::num);
+        REQUIRE(std::ranges::is_sorted(v, by_num_then_seq));
+    }
+    SECTION("with a comparison made with transform_args")
+    {
+        composer::radix_sort(
+            v, composer::transform_args(&record::num, composer::less_than));
+        REQUIRE(std::ranges::is_sorted(v, by_num_then_seq));
+    }
+    SECTION("descending")
+    {
+        composer::radix_sort(
+            v, composer::transform_args(&record::num, composer::greater_than));
+        REQUIRE(std::ranges::is_sorted(v, [](const auto& a, const auto& b) {
+            return a.num > b.num || (a.num == b.num && a.seq < b.seq);
+        }));
+    }
+}
+
+TEST_CASE("sort and stable_sort use radix sort for recognized comparisons")
+{
+    using composer::internal::radix_sorter;
+    using records = std::vector<record>&;
+    const auto by_num = composer::transform_args(&record::num);
+    STATIC_REQUIRE(std::is_invocable_v<radix_sorter<false>, records,
+                                       decltype(by_num(composer::less_than))>);
+    STATIC_REQUIRE(std::is_invocable_v<radix_sorter<false>,
+                                       std::vector<double>&,
+                                       decltype(composer::greater_than)>);
+    STATIC_REQUIRE(std::is_invocable_v<radix_sorter<false>,
+                                       std::vector<int>&,
+                                       std::less<>>);
+    SECTION("but not for other comparisons")
+    {
+        STATIC_REQUIRE(
+            !std::is_invocable_v<radix_sorter<false>,
+                                 records,
+                                 decltype(by_num(composer::less_or_equal_to))>);
+        STATIC_REQUIRE(!std::is_invocable_v<radix_sorter<false>,
+                                            std::vector<int>&,
+                                            decltype([](int a, int b) {
+                                                return a < b;
+                                            })>);
+    }
+    SECTION("nor for other keys")
+    {
+        STATIC_REQUIRE(!std::is_invocable_v<radix_sorter<false>,
+                                            std::vector<std::string>&>);
+        STATIC_REQUIRE(!std::is_invocable_v<radix_sorter<false>,
+                                            std::vector<bool>&>);
+    }
+    SECTION("nor for ranges that are not random access")
+    {
+        STATIC_REQUIRE(
+            !std::is_invocable_v<radix_sorter<false>, std::list<int>&>);
+    }
+
+    auto nums = scrambled<int>(10'000);
+    std::vector<record> v;
+    for (auto n : nums) {
+        v.push_back({ n, v.size() });
+    }
+    auto expected = v;
+    std::ranges::stable_sort(expected, std::ranges::less{}, &record::num);
+    composer::stable_sort(v, by_num(composer::less_than));
+    REQUIRE(std::ranges::equal(v, expected, {}, &record::seq, &record::seq));
+
+    composer::sort(nums, composer::greater_than);
+    REQUIRE(std::ranges::is_sorted(nums, std::ranges::greater{}));
+    composer::sort_by_key(nums, composer::negate);
+    REQUIRE(std::ranges::is_sorted(nums, std::ranges::greater{}));
+}
+
+TEST_CASE("sort with a recognized comparison works in constant evaluation")
+{
+    constexpr auto sorted = [] {
+        std::array values{ 3, -1, 4, 1, -5, 9, 2, 6 };
+        composer::sort(values, composer::greater_than);
+        return values;
+    }();
+    STATIC_REQUIRE(sorted == std::array{ 9, 6, 4, 3, 2, 1, -1, -5 });
+}
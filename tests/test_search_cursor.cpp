@@ -0,0 +1,66 @@
+#include <composer/functional.hpp>
+#include <composer/search_cursor.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+struct row {
+    int key;
+    std::string name;
+};
+} // namespace
+
+TEST_CASE("a search_cursor finds increasing values from the previous one")
+{
+    std::vector<int> values;
+    for (int i = 0; i != 100000; ++i) {
+        values.push_back(i / 2 * 3);
+    }
+    std::size_t comparisons = 0;
+    const auto counted_less = [&](int a, int b) {
+        ++comparisons;
+        return a < b;
+    };
+    composer::search_cursor cursor(values, counted_less);
+    for (int value = 0; value < 150000; value += 100) {
+        REQUIRE(cursor.lower_bound(value)
+                == std::ranges::lower_bound(values, value));
+        REQUIRE(cursor.position() == cursor.lower_bound(value));
+    }
+    // 1500 searches that move about 67 elements each, instead of 1500
+    // binary searches of 17 steps.
+    REQUIRE(comparisons < 1500 * 2 * 17);
+    SECTION("and values before the previous one")
+    {
+        REQUIRE(cursor.upper_bound(30) == values.begin() + 22);
+        REQUIRE(cursor.lower_bound(-1) == values.begin());
+        REQUIRE(cursor.contains(99999));
+        REQUIRE_FALSE(cursor.contains(100000));
+    }
+    SECTION("and from the beginning after reset")
+    {
+        cursor.reset();
+        REQUIRE(cursor.position() == values.begin());
+        REQUIRE(cursor.lower_bound(150000) == values.end());
+    }
+}
+
+TEST_CASE("a search_cursor compares projected elements")
+{
+    std::vector<row> rows{ { 9, "nine" },
+                           { 7, "seven" },
+                           { 7, "other seven" },
+                           { 2, "two" } };
+    composer::search_cursor cursor(rows, composer::greater_than, &row::key);
+    REQUIRE(cursor.lower_bound(7)->name == "seven");
+    REQUIRE(cursor.upper_bound(7)->name == "two");
+    REQUIRE(cursor.lower_bound(1) == rows.end());
+    REQUIRE(cursor.contains(9));
+}
@@ -0,0 +1,104 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/search_index.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace {
+struct record {
+    int id;
+    std::string name;
+};
+
+// Sorted, with each value repeated, and gaps between the values.
+std::vector<int> sorted_values(int size)
+{
+    std::vector<int> v;
+    for (int i = 0; i != size; ++i) {
+        v.push_back(i / 3 * 2);
+    }
+    return v;
+}
+} // namespace
+
+TEST_CASE("a search_index is a range of the elements of the indexed range")
+{
+    const auto values = sorted_values(100);
+    const composer::search_index index(values);
+    STATIC_REQUIRE(std::ranges::random_access_range<decltype(index)>);
+    REQUIRE(index.size() == 100);
+    REQUIRE(std::ranges::equal(index, values));
+    REQUIRE(composer::count(index, 10) == 3);
+}
+
+TEST_CASE("binary search algorithms search a search_index like the range")
+{
+    for (int size : { 0, 1, 2, 3, 7, 8, 100, 1000, 4097 }) {
+        const auto values = sorted_values(size);
+        const composer::search_index index(values);
+        for (int value = -1; value <= size; ++value) {
+            const auto position = [&](auto it) {
+                return it - index.begin();
+            };
+            REQUIRE(position(composer::lower_bound(index, value))
+                    == std::ranges::lower_bound(values, value)
+                           - values.begin());
+            REQUIRE(position(composer::upper_bound(index, value))
+                    == std::ranges::upper_bound(values, value)
+                           - values.begin());
+            REQUIRE(composer::binary_search(index, value)
+                    == std::ranges::binary_search(values, value));
+            const auto [first, last] = composer::equal_range(index, value);
+            REQUIRE(last - first == std::ranges::count(values, value));
+        }
+    }
+}
+
+TEST_CASE("a search_index finds keys whose size does not divide a cache line")
+{
+    std::vector<std::array<int, 3>> values;
+    for (int i = 0; i != 1000; ++i) {
+        values.push_back({ i / 10, i % 10 / 5, 0 });
+    }
+    const composer::search_index index(values);
+    for (int i = -1; i <= 100; ++i) {
+        const std::array key{ i, 1, 0 };
+        REQUIRE(composer::lower_bound(index, key) - index.begin()
+                == std::ranges::lower_bound(values, key) - values.begin());
+        REQUIRE(composer::binary_search(index, key)
+                == std::ranges::binary_search(values, key));
+    }
+}
+
+TEST_CASE("a search_index compares values with the keys it is built with")
+{
+    std::vector<record> records;
+    for (int i = 0; i != 500; ++i) {
+        records.push_back({ 1000 - 2 * i, std::to_string(i) });
+    }
+    const composer::search_index index(records, &record::id);
+    REQUIRE(composer::lower_bound(index, 51, composer::greater_than)->name
+            == "475");
+    REQUIRE(composer::binary_search(index, 50, composer::greater_than));
+    REQUIRE_FALSE(composer::binary_search(index, 51, composer::greater_than));
+    SECTION("and binds like the other algorithms")
+    {
+        const auto find_id = composer::lower_bound(composer::greater_than);
+        REQUIRE((index | find_id(500))->name == "250");
+    }
+    SECTION("but calls with a projection search the elements")
+    {
+        REQUIRE(composer::lower_bound(
+                    index, 2, std::ranges::greater{}, &record::id)
+                == index.end() - 1);
+    }
+}
@@ -0,0 +1,261 @@
+#include <composer/algorithm.hpp>
+#include <composer/execution.hpp>
+#include <composer/simd.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <vector>
+
+namespace {
+
+// Every size up to a few vectors, so that matches are found in the unrolled
+// loop, in single vectors and in the scalar tail, at every position.
+template <typename T>
+void check_all_positions()
+{
+    for (std::size_t size = 0; size != 300; ++size) {
+        std::vector<T> v(size, T{ 1 });
+        REQUIRE(composer::find(v, T{ 2 }) == v.end());
+        REQUIRE(composer::count(v, T{ 1 })
+                == static_cast<std::ptrdiff_t>(size));
+        REQUIRE(!composer::contains(v, T{ 2 }));
+        for (std::size_t i = 0; i != size; ++i) {
+            v[i] = T{ 2 };
+            REQUIRE(composer::find(v, T{ 2 }) == v.begin() + i);
+            REQUIRE(composer::count(v, T{ 2 }) == 1);
+            REQUIRE(composer::contains(v, T{ 2 }));
+            v[i] = T{ 1 };
+        }
+    }
+}
+
+template <typename T>
+void check_ordered_positions()
+{
+    constexpr auto lt = composer::less_than(T{ 2 });
+    constexpr auto gt = composer::greater_than(T{ 2 });
+    for (std::size_t size = 0; size != 300; ++size) {
+        std::vector<T> v(size, T{ 2 });
+        REQUIRE(composer::find_if(v, lt) == v.end());
+        REQUIRE(composer::find_if(v, gt) == v.end());
+        REQUIRE(composer::count_if(v, lt) == 0);
+        REQUIRE(composer::none_of(v, gt));
+        for (std::size_t i = 0; i != size; ++i) {
+            v[i] = T{ 1 };
+            REQUIRE(composer::find_if(v, lt) == v.begin() + i);
+            REQUIRE(composer::find_if_not(v, composer::greater_than(T{ 1 }))
+                    == v.begin() + i);
+            REQUIRE(composer::count_if(v, lt) == 1);
+            REQUIRE(!composer::all_of(v, composer::greater_than(T{ 1 })));
+            v[i] = T{ 3 };
+            REQUIRE(composer::find_if(v, gt) == v.begin() + i);
+            REQUIRE(composer::find_if_not(v, composer::less_than(T{ 3 }))
+                    == v.begin() + i);
+            REQUIRE(composer::count_if(v, gt) == 1);
+            REQUIRE(composer::any_of(v, gt));
+            v[i] = T{ 2 };
+        }
+    }
+}
+
+template <typename T>
+void check_counts()
+{
+    std::vector<T> v(10'000);
+    for (std::size_t i = 0; i != v.size(); ++i) {
+        v[i] = static_cast<T>(i % 7 == 0 || i % 11 == 0);
+    }
+    REQUIRE(composer::count(v, T{ 1 }) == std::ranges::count(v, T{ 1 }));
+    REQUIRE(composer::count(v, T{ 0 }) == std::ranges::count(v, T{ 0 }));
+}
+
+} // namespace
+
+TEST_CASE("find, count and contains on contiguous ranges find every position")
+{
+    check_all_positions<std::int8_t>();
+    check_all_positions<std::uint8_t>();
+    check_all_positions<char>();
+    check_all_positions<std::int16_t>();
+    check_all_positions<std::uint16_t>();
+    check_all_positions<std::int32_t>();
+    check_all_positions<std::uint32_t>();
+    check_all_positions<std::int64_t>();
+    check_all_positions<std::uint64_t>();
+    check_all_positions<float>();
+    check_all_positions<double>();
+}
+
+TEST_CASE("less_than and greater_than on contiguous ranges find every position")
+{
+    check_ordered_positions<std::int8_t>();
+    check_ordered_positions<std::uint8_t>();
+    check_ordered_positions<char>();
+    check_ordered_positions<std::int16_t>();
+    check_ordered_positions<std::uint16_t>();
+    check_ordered_positions<std::int32_t>();
+    check_ordered_positions<std::uint32_t>();
+    check_ordered_positions<std::int64_t>();
+    check_ordered_positions<std::uint64_t>();
+    check_ordered_positions<float>();
+    check_ordered_positions<double>();
+}
+
+TEST_CASE("count on long contiguous ranges is the same as std::ranges::count")
+{
+    check_counts<std::uint8_t>();
+    check_counts<std::int16_t>();
+    check_counts<std::int32_t>();
+    check_counts<std::int64_t>();
+    check_counts<float>();
+    check_counts<double>();
+}
+
+TEST_CASE("only 64 bit elements with both halves equal are found")
+{
+    std::vector<std::uint64_t> v(40, 0x1'0000'0002);
+    v[33] = 0x2'0000'0002;
+    REQUIRE(composer::find(v, std::uint64_t{ 0x2'0000'0002 })
+            == v.begin() + 33);
+    REQUIRE(composer::count(v, std::uint64_t{ 0x2 }) == 0);
+    REQUIRE(composer::count(v, std::uint64_t{ 0x2'0000'0000 }) == 0);
+}
+
+TEST_CASE("values of other types are compared as std::ranges::find does")
+{
+    std::vector<std::uint8_t> v(100, 255);
+    v[70] = 1;
+    SECTION("a value that is equal after conversion is found")
+    {
+        REQUIRE(composer::find(v, 1) == v.begin() + 70);
+        REQUIRE(composer::count(v, 255) == 99);
+        REQUIRE(composer::count(v, 255L) == 99);
+    }
+    SECTION("a value that the elements cannot represent is not found")
+    {
+        REQUIRE(composer::find(v, -1) == v.end());
+        REQUIRE(composer::find(v, 257) == v.end());
+        REQUIRE(composer::count(v, 511) == 0);
+        REQUIRE(!composer::contains(v, 256));
+    }
+}
+
+TEST_CASE("floating point elements compare as with operator==")
+{
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> v(50, 1.0);
+    v[10] = nan;
+    v[20] = -0.0;
+    v[30] = 0.0;
+    REQUIRE(composer::find(v, nan) == v.end());
+    REQUIRE(composer::count(v, nan) == 0);
+    REQUIRE(composer::find(v, 0.0) == v.begin() + 20);
+    REQUIRE(composer::count(v, -0.0) == 2);
+
+    std::vector<float> f(50, 1.5F);
+    f[45] = 0.1F;
+    REQUIRE(composer::find(f, 0.1F) == f.begin() + 45);
+    REQUIRE(composer::find(f, 0.1) == f.end());
+    REQUIRE(composer::count(f, 1.5) == 49);
+    REQUIRE(composer::find(f, 1e300) == f.end());
+}
+
+TEST_CASE("ordered comparisons compare as with operator< and operator>")
+{
+    SECTION("unsigned elements are ordered above the signed range")
+    {
+        std::vector<std::uint32_t> u(50, 1);
+        u[40] = std::numeric_limits<std::uint32_t>::max();
+        REQUIRE(composer::find_if(u, composer::greater_than(2U))
+                == u.begin() + 40);
+        REQUIRE(composer::count_if(u, composer::less_than(2U)) == 49);
+        std::vector<std::uint64_t> w(50, 1);
+        w[45] = std::numeric_limits<std::uint64_t>::max();
+        REQUIRE(composer::find_if_not(w, composer::less_than(w[0] + 1))
+                == w.begin() + 45);
+    }
+    SECTION("negative elements are ordered below zero")
+    {
+        std::vector<std::int64_t> v(50, 0);
+        v[25] = std::numeric_limits<std::int64_t>::min();
+        REQUIRE(composer::find_if(v, composer::less_than(std::int64_t{ 0 }))
+                == v.begin() + 25);
+    }
+    SECTION("NaN is neither less nor greater than anything")
+    {
+        constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+        std::vector<double> v(50, 1.0);
+        v[10] = nan;
+        REQUIRE(composer::find_if_not(v, composer::less_than(2.0))
+                == v.begin() + 10);
+        REQUIRE(composer::count_if(v, composer::greater_than(0.0)) == 49);
+        REQUIRE(composer::find_if(v, composer::less_than(nan)) == v.end());
+        REQUIRE(!composer::any_of(v, composer::greater_than(nan)));
+    }
+}
+
+TEST_CASE("find, count and contains are vectorized for contiguous ranges")
+{
+    using composer::internal::vectorized_find;
+    STATIC_REQUIRE(
+        std::is_invocable_v<vectorized_find, std::vector<int>&, int>);
+    STATIC_REQUIRE(
+        std::is_invocable_v<vectorized_find, std::array<double, 3>&, float>);
+    STATIC_REQUIRE(
+        std::is_invocable_v<vectorized_find, const int*, const int*, long>);
+    SECTION("but not with a projection")
+    {
+        STATIC_REQUIRE(!std::is_invocable_v<vectorized_find,
+                                            std::vector<int>&,
+                                            int,
+                                            std::negate<>>);
+    }
+    SECTION("nor for ranges that are not contiguous")
+    {
+        STATIC_REQUIRE(
+            !std::is_invocable_v<vectorized_find, std::list<int>&, int>);
+    }
+    SECTION("nor when integers and floating point values are mixed")
+    {
+        STATIC_REQUIRE(
+            !std::is_invocable_v<vectorized_find, std::vector<int>&, double>);
+        STATIC_REQUIRE(
+            !std::is_invocable_v<vectorized_find, std::vector<float>&, int>);
+    }
+    SECTION("nor for bool")
+    {
+        STATIC_REQUIRE(
+            !std::is_invocable_v<vectorized_find, std::vector<bool>&, bool>);
+        STATIC_REQUIRE(
+            !std::is_invocable_v<vectorized_find, std::array<bool, 3>&, bool>);
+    }
+}
+
+TEST_CASE("find, count and contains can be evaluated at compile time")
+{
+    constexpr std::array values{ 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5 };
+    STATIC_REQUIRE(composer::find(values, 9) == values.begin() + 5);
+    STATIC_REQUIRE(composer::count(values, 5) == 3);
+    STATIC_REQUIRE(composer::contains(values, 6));
+    STATIC_REQUIRE((values | composer::count(1)) == 2);
+}
+
+TEST_CASE("parallel find and count use the vectorized search in each chunk")
+{
+    constexpr composer::parallel_policy par_always{ .threshold = 2 };
+    std::vector<std::int16_t> v(100'000, 3);
+    v[77'777] = 4;
+    v[99'999] = 4;
+    REQUIRE(composer::find(par_always, v, std::int16_t{ 4 })
+            == v.begin() + 77'777);
+    REQUIRE(composer::count(par_always, v, 4) == 2);
+    REQUIRE(composer::contains(v, par_always, 4));
+    REQUIRE(!composer::contains(v, par_always, 5));
+}
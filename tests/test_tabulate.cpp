@@ -0,0 +1,89 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/tabulate.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+enum class colour : std::uint8_t { red, green, blue };
+
+constexpr auto pred
+    = (composer::identity | composer::modulus(7) | composer::equal_to(3))
+   || (composer::identity | composer::greater_than(40));
+} // namespace
+
+TEST_CASE("a tabulated function returns the same values as the function")
+{
+    constexpr auto f = composer::tabulate<std::uint8_t>(pred);
+    STATIC_REQUIRE(composer::composable_function_type<decltype(f)>);
+    for (int i = 0; i != 256; ++i) {
+        const auto v = static_cast<std::uint8_t>(i);
+        REQUIRE(f(v) == pred(v));
+    }
+    STATIC_REQUIRE(f(std::uint8_t{ 10 }));
+    STATIC_REQUIRE(!f(std::uint8_t{ 11 }));
+    STATIC_REQUIRE(f(std::uint8_t{ 41 }));
+}
+
+TEST_CASE("a tabulated function is only callable with the domain type")
+{
+    constexpr auto f = composer::tabulate<std::uint8_t>(pred);
+    STATIC_REQUIRE(can_call(f, std::uint8_t{ 3 }));
+    STATIC_REQUIRE(!can_call(f, 3));
+    STATIC_REQUIRE(!can_call(f, std::int8_t{ 3 }));
+}
+
+TEST_CASE("a signed domain covers negative values")
+{
+    constexpr auto f = composer::tabulate<std::int8_t>(composer::negate);
+    STATIC_REQUIRE(f(std::int8_t{ -128 }) == 128);
+    STATIC_REQUIRE(f(std::int8_t{ -1 }) == 1);
+    STATIC_REQUIRE(f(std::int8_t{ 127 }) == -127);
+}
+
+TEST_CASE("an interval domain covers the values from the low to the high")
+{
+    constexpr auto f = composer::tabulate<composer::interval<-10, 10>>(
+        composer::identity | composer::multiplies(2));
+    STATIC_REQUIRE(sizeof(f) == 21 * sizeof(int));
+    for (int i = -10; i <= 10; ++i) {
+        REQUIRE(f(i) == 2 * i);
+    }
+}
+
+TEST_CASE("enum and bool domains can be tabulated")
+{
+    constexpr auto name = composer::tabulate<colour>([](colour c) {
+        switch (c) {
+        case colour::red:
+            return 'r';
+        case colour::green:
+            return 'g';
+        case colour::blue:
+            return 'b';
+        }
+        return '?';
+    });
+    STATIC_REQUIRE(name(colour::green) == 'g');
+    STATIC_REQUIRE(name(colour{ 200 }) == '?');
+
+    constexpr auto to_int = composer::tabulate<bool>(
+        [](bool b) { return b ? 1 : 0; });
+    STATIC_REQUIRE(sizeof(to_int) == 2 * sizeof(int));
+    STATIC_REQUIRE(to_int(true) == 1);
+    STATIC_REQUIRE(to_int(false) == 0);
+}
+
+TEST_CASE("a tabulated function composes like any composable function")
+{
+    constexpr auto f = composer::tabulate<std::uint8_t>(pred);
+    constexpr std::array<std::uint8_t, 6> values{ 1, 3, 10, 17, 41, 200 };
+    STATIC_REQUIRE(composer::count_if(values, f) == 5);
+    STATIC_REQUIRE((values | composer::count_if(!f)) == 1);
+    STATIC_REQUIRE((std::uint8_t{ 17 } | f | composer::equal_to(true)));
+}
@@ -0,0 +1,119 @@
+#include <composer/algorithm.hpp>
+#include <composer/functional.hpp>
+#include <composer/thread_pool.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+std::vector<int> iota(int n)
+{
+    std::vector<int> v(static_cast<std::size_t>(n));
+    std::iota(v.begin(), v.end(), 0);
+    return v;
+}
+
+class counting_executor final : public composer::executor {
+public:
+    std::size_t concurrency() const noexcept override { return 2; }
+
+    void submit(composer::function<void()> task) override
+    {
+        ++submitted;
+        threads.emplace_back(std::move(task));
+    }
+
+    bool try_run_one() override { return false; }
+
+    std::atomic<int> submitted = 0;
+    std::vector<std::jthread> threads;
+};
+} // namespace
+
+TEST_CASE("a thread pool runs every submitted task")
+{
+    std::atomic<int> n = 0;
+    {
+        composer::thread_pool pool(3);
+        REQUIRE(pool.concurrency() == 3);
+        for (int i = 0; i != 1000; ++i) {
+            pool.submit([&n] { ++n; });
+        }
+    }
+    REQUIRE(n == 1000);
+}
+
+TEST_CASE("a thread pool runs tasks from the thread that waits for them")
+{
+    composer::thread_pool pool(1);
+    std::atomic<bool> release = false;
+    pool.submit([&release] {
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    std::atomic<int> n = 0;
+    pool.submit([&n] { ++n; });
+    while (n == 0) {
+        pool.try_run_one();
+    }
+    release = true;
+    REQUIRE(n == 1);
+}
+
+TEST_CASE("a thread outside the pool takes the oldest task")
+{
+    composer::thread_pool pool(1);
+    std::atomic<bool> started = false;
+    std::atomic<bool> release = false;
+    pool.submit([&] {
+        started = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    // The only worker is busy, so only this thread runs a task before the
+    // release.
+    std::atomic<int> last = 0;
+    pool.submit([&last] { last = 1; });
+    pool.submit([&last] { last = 2; });
+    REQUIRE(pool.try_run_one());
+    const int ran = last;
+    release = true;
+    REQUIRE(ran == 1);
+}
+
+TEST_CASE("parallel algorithms can be nested on a pool")
+{
+    composer::thread_pool pool(2, composer::cpu_pinning::compact);
+    const composer::parallel_policy policy{ .threshold = 2, .pool = &pool };
+    const auto outer = iota(64);
+    const auto inner = iota(10000);
+    std::atomic<long> sum = 0;
+    composer::for_each(policy, outer, [&](int) {
+        sum += composer::count_if(policy, inner, composer::less_than(100));
+    });
+    REQUIRE(sum == 64 * 100);
+}
+
+TEST_CASE("the default executor can be replaced")
+{
+    counting_executor e;
+    const auto v = iota(1000);
+    REQUIRE(composer::set_default_executor(&e) == nullptr);
+    const auto n
+        = composer::count_if(composer::parallel_policy{ .threshold = 2 },
+                             v,
+                             composer::less_than(500));
+    REQUIRE(composer::set_default_executor(nullptr) == &e);
+    REQUIRE(n == 500);
+    REQUIRE(e.submitted > 0);
+    REQUIRE(&composer::default_executor() != &e);
+}
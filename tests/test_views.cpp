@@ -0,0 +1,113 @@
+#include <composer/functional.hpp>
+#include <composer/views.hpp>
+
+#include "test_utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace {
+struct item {
+    bool active;
+    int cost;
+    std::string_view name;
+};
+
+constexpr std::array items{ item{ true, 3, "a" },
+                            item{ false, 5, "b" },
+                            item{ true, 7, "c" },
+                            item{ true, 11, "d" },
+                            item{ false, 13, "e" } };
+} // namespace
+
+TEST_CASE("terminals work directly on ranges")
+{
+    constexpr std::array values{ 1, 2, 3, 4 };
+    STATIC_REQUIRE((values | composer::views::sum) == 10);
+    STATIC_REQUIRE((values | composer::views::count) == 4);
+    STATIC_REQUIRE((values | composer::views::fold_left(1, std::multiplies{}))
+                   == 24);
+    REQUIRE((values | composer::views::sum) == 10);
+}
+
+TEST_CASE("filter, transform and sum fuse into one loop")
+{
+    constexpr auto total = items | composer::views::filter(&item::active)
+                         | composer::views::transform(&item::cost)
+                         | composer::views::sum;
+    STATIC_REQUIRE(total == 21);
+    REQUIRE(total == 21);
+}
+
+TEST_CASE("a stage piped from a range is a lazy view, not a result")
+{
+    auto v = items | composer::views::filter(&item::active);
+    STATIC_REQUIRE(!composer::composable_function_type<decltype(v)>);
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(v)::element_type, const item&>);
+    REQUIRE((v | composer::views::count) == 3);
+}
+
+TEST_CASE("filter accepts composer predicates")
+{
+    constexpr auto n = items
+                     | composer::views::filter(&item::cost
+                                               | composer::greater_than(4))
+                     | composer::views::count;
+    STATIC_REQUIRE(n == 4);
+    REQUIRE(n == 4);
+}
+
+TEST_CASE("take_while stops the loop at the first rejected element")
+{
+    int visited = 0;
+    auto cost = [&visited](const item& i) {
+        ++visited;
+        return i.cost;
+    };
+    const auto total = items | composer::views::transform(cost)
+                     | composer::views::take_while(composer::less_than(10))
+                     | composer::views::sum;
+    REQUIRE(total == 15);
+    REQUIRE(visited == 4);
+}
+
+TEST_CASE("stages compose with | into a reusable pipeline")
+{
+    constexpr auto active_cost = composer::views::filter(&item::active)
+                               | composer::views::transform(&item::cost)
+                               | composer::views::sum;
+    STATIC_REQUIRE(composer::composable_function_type<decltype(active_cost)>);
+    STATIC_REQUIRE(active_cost(items) == 21);
+    STATIC_REQUIRE((items | active_cost) == 21);
+    REQUIRE((items | active_cost) == 21);
+}
+
+TEST_CASE("for_each calls the function for every element reaching it")
+{
+    std::vector<std::string_view> names;
+    items | composer::views::filter(&item::active)
+        | composer::views::transform(&item::name)
+        | composer::views::for_each(
+            [&names](std::string_view n) { names.push_back(n); });
+    REQUIRE(names == std::vector<std::string_view>{ "a", "c", "d" });
+}
+
+TEST_CASE("fold_left folds from the left with the given initial value")
+{
+    constexpr auto digits = items | composer::views::transform(&item::cost)
+                          | composer::views::fold_left(
+                              0, [](int acc, int c) { return acc * 100 + c; });
+    STATIC_REQUIRE(digits == 305071113);
+    REQUIRE(digits == 305071113);
+}
+
+TEST_CASE("an rvalue range is owned by the view")
+{
+    auto v = std::vector{ 1, 2, 3, 4, 5 }
+           | composer::views::filter([](int i) { return i % 2 == 1; });
+    REQUIRE((v | composer::views::sum) == 9);
+}